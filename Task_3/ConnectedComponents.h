@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * Parallel connected components (Afforest, Sutton et al. 2018).
+ *
+ * Vertices are merged with a lock-free union-find: a root is hooked under a
+ * smaller root with one compare-and-swap, so threads can link edges
+ * concurrently. Afforest first links only the first few neighbours of every
+ * vertex, samples which component is the largest, and then processes the
+ * remaining edges only for vertices outside it. On real graphs that skips
+ * most of the edge list.
+ *
+ * Edge direction is ignored (weak components). The skip is only valid when
+ * every arc u->v has a matching v->u, so pass `symmetric = false` for
+ * directed adjacency.
+ *
+ * On one thread a symmetric graph is labelled by repeated direction-optimizing
+ * BFS (HybridBFS.h) instead, one search per component.
+ *
+ * On return label[u] is the smallest vertex id in u's component. The
+ * return value is the number of components. `threads = 0` picks
+ * hardware_concurrency() for large graphs and 1 for small ones.
+ */
+int connectedComponents(int n, const int64_t* offsets, const int* targets,
+                        bool symmetric, int* label, unsigned threads = 0);
+
+// Same kernel over adjacency lists
+int connectedComponents(int n, const std::vector<int>* adj,
+                        bool symmetric, int* label, unsigned threads = 0);
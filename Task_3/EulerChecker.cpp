@@ -1,30 +1,17 @@
 #include "EulerChecker.h"
+#include "ConnectedComponents.h"
 #include <vector>
 #include <iostream>
 
 using std::vector;
 
-// DFS to explore the graph
-static void dfs(int u, const vector<int> adj[], vector<bool>& visited) {
-    visited[u] = true;
-    for (int v : adj[u]) {
-        if (!visited[v]) {
-            dfs(v, adj, visited);
-        }
-    }
-}
-
-// Main function to check Eulerian status
-int isEulerian(const Graph& g) {
-    int v = g.V();
-    const vector<int>* adj = g.raw();
-
-    vector<bool> visited(v, false);
-
-    // Find a vertex with non-zero degree to start DFS
+// Eulerian status from vertex degrees and component labels
+template<typename Degree>
+static int classify(int v, Degree degree, const vector<int>& label) {
+    // Find a vertex with non-zero degree to compare components against
     int start = -1;
     for (int i = 0; i < v; i++) {
-        if (!adj[i].empty()) {
+        if (degree(i) != 0) {
             start = i;
             break;
         }
@@ -36,9 +23,8 @@ int isEulerian(const Graph& g) {
     }
 
     // Check connectivity (ignoring isolated vertices)
-    dfs(start, adj, visited);
     for (int i = 0; i < v; i++) {
-        if (!adj[i].empty() && !visited[i]) {
+        if (degree(i) != 0 && label[i] != label[start]) {
             std::cout << "Graph is not connected (ignoring isolated vertices).\n";
             return 0;
         }
@@ -48,7 +34,7 @@ int isEulerian(const Graph& g) {
     int odd = 0;
     vector<int> oddVertices;
     for (int i = 0; i < v; i++) {
-        if (adj[i].size() % 2 != 0) {
+        if (degree(i) % 2 != 0) {
             odd++;
             oddVertices.push_back(i);
         }
@@ -67,3 +53,18 @@ int isEulerian(const Graph& g) {
         return 0; // Neither
     }
 }
+
+// Main function to check Eulerian status
+int isEulerian(const Graph& g) {
+    const vector<int>* adj = g.raw();
+    vector<int> label(g.V());
+    connectedComponents(g.V(), adj, true, label.data());
+    return classify(g.V(), [&](int u) { return adj[u].size(); }, label);
+}
+
+// Mapped files are used in place: the kernel reads the file's CSR arrays directly
+int isEulerian(const MappedGraph& g) {
+    vector<int> label(g.V());
+    connectedComponents(g.V(), g.offsets(), g.targets(), true, label.data());
+    return classify(g.V(), [&](int u) { return g.degree(u); }, label);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Graph.h"
+#include "GraphFile.h"
 
 /**
  * Checks if the graph contains:
@@ -10,3 +11,6 @@
  * Based on classic DFS + degree counting.
  */
 int isEulerian(const Graph& g);
+
+// Same check on a memory-mapped undirected .graph file
+int isEulerian(const MappedGraph& g);
@@ -0,0 +1,114 @@
+#include "EulerTrail.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+TrailWriter::TrailWriter(Flush flush, size_t chunkBytes)
+    : out(std::move(flush)), buf(std::max<size_t>(chunkBytes, 64)), used(0), first(true) {}
+
+TrailWriter::~TrailWriter() {
+    flush();
+}
+
+void TrailWriter::flush() {
+    if (used) out(buf.data(), used);
+    used = 0;
+}
+
+void TrailWriter::text(const std::string& s) {
+    if (used + s.size() > buf.size()) flush();
+    if (s.size() > buf.size()) {
+        out(s.data(), s.size());
+        return;
+    }
+    std::memcpy(buf.data() + used, s.data(), s.size());
+    used += s.size();
+}
+
+void TrailWriter::vertex(int v) {
+    if (used + 12 > buf.size()) flush(); // separator + up to 11 characters
+    if (!first) buf[used++] = ' ';
+    first = false;
+    used = std::to_chars(buf.data() + used, buf.data() + buf.size(), v).ptr - buf.data();
+}
+
+namespace {
+
+// Neighbour access for CSR arrays
+struct CSRAdj {
+    const int64_t* offsets;
+    const int* targets;
+    int degree(int u) const { return static_cast<int>(offsets[u + 1] - offsets[u]); }
+    int neighbor(int u, int i) const { return targets[offsets[u] + i]; }
+};
+
+// Neighbour access for adjacency lists
+struct ListAdj {
+    const std::vector<int>* adj;
+    int degree(int u) const { return static_cast<int>(adj[u].size()); }
+    int neighbor(int u, int i) const { return adj[u][i]; }
+};
+
+template<typename Adj>
+int64_t hierholzer(int n, const Adj& g, TrailWriter& out) {
+    // Sorted CSR: emitting every arc u -> v into v's row, for u in increasing
+    // order, leaves each row sorted by neighbour (the graph is symmetric)
+    std::vector<int64_t> offsets(n + 1, 0);
+    for (int u = 0; u < n; ++u) offsets[u + 1] = offsets[u] + g.degree(u);
+    const int64_t arcs = offsets[n];
+    std::vector<int> targets(arcs);
+    std::vector<int64_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (int u = 0; u < n; ++u)
+        for (int i = 0, d = g.degree(u); i < d; ++i) targets[cursor[g.neighbor(u, i)]++] = u;
+
+    // Pair each arc with its reverse: scanning sources in increasing order
+    // reaches the arcs into v in the same order as v's sorted row
+    std::vector<int64_t> mate(arcs);
+    std::copy(offsets.begin(), offsets.end() - 1, cursor.begin());
+    for (int u = 0; u < n; ++u)
+        for (int64_t a = offsets[u]; a < offsets[u + 1]; ++a) mate[a] = cursor[targets[a]]++;
+
+    // Start at an odd vertex if there is one, otherwise at any non-isolated vertex
+    int start = -1;
+    for (int u = 0; u < n; ++u) {
+        int d = static_cast<int>(offsets[u + 1] - offsets[u]);
+        if (d % 2) { start = u; break; }
+        if (d && start == -1) start = u;
+    }
+    if (start == -1) return 0;
+
+    std::vector<uint64_t> used((arcs + 63) / 64, 0);
+    auto isUsed = [&](int64_t a) { return (used[a >> 6] >> (a & 63)) & 1; };
+    auto markUsed = [&](int64_t a) { used[a >> 6] |= 1ULL << (a & 63); };
+
+    // cursor[u] = next arc of u to try; arcs before it are used
+    std::copy(offsets.begin(), offsets.end() - 1, cursor.begin());
+    std::vector<int> stack{start};
+    int64_t walked = 0;
+    while (!stack.empty()) {
+        int u = stack.back();
+        int64_t& a = cursor[u];
+        while (a < offsets[u + 1] && isUsed(a)) ++a;
+        if (a < offsets[u + 1]) {
+            markUsed(a);
+            markUsed(mate[a]);
+            stack.push_back(targets[a]);
+            ++a;
+            ++walked;
+        } else {
+            out.vertex(u); // u is finished: next vertex of the trail (from the end)
+            stack.pop_back();
+        }
+    }
+    return walked;
+}
+
+} // namespace
+
+int64_t eulerTrail(int n, const int64_t* offsets, const int* targets, TrailWriter& out) {
+    return hierholzer(n, CSRAdj{offsets, targets}, out);
+}
+
+int64_t eulerTrail(int n, const std::vector<int>* adj, TrailWriter& out) {
+    return hierholzer(n, ListAdj{adj}, out);
+}
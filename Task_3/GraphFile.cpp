@@ -0,0 +1,116 @@
+#include "GraphFile.h"
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static uint64_t alignUp(uint64_t x) {
+    return (x + 63) & ~uint64_t(63);
+}
+
+MappedGraph::MappedGraph(const std::string& path)
+    : map(MAP_FAILED), mapSize(0), mtime(0), hdr(nullptr), offs(nullptr), tgts(nullptr) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw std::runtime_error("cannot open graph file: " + path);
+
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(GraphFileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("graph file too small: " + path);
+    }
+    mapSize = static_cast<size_t>(st.st_size);
+    mtime = static_cast<int64_t>(st.st_mtime);
+    map = mmap(nullptr, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (map == MAP_FAILED) throw std::runtime_error("cannot map graph file: " + path);
+
+    // Header fields and array bounds, then the arrays themselves: the
+    // algorithms index with these values unchecked
+    hdr = static_cast<const GraphFileHeader*>(map);
+    const auto* base = static_cast<const unsigned char*>(map);
+    const GraphFileHeader& h = *hdr;
+    bool ok = std::memcmp(h.magic, GRAPH_FILE_MAGIC, sizeof(h.magic)) == 0
+           && h.version == GRAPH_FILE_VERSION
+           && h.vertices <= 0x7fffffffULL
+           && h.offsetsPos <= mapSize && h.targetsPos <= mapSize && h.arcs <= mapSize / sizeof(int32_t)
+           && h.offsetsPos % 64 == 0 && h.targetsPos % 64 == 0
+           && h.offsetsPos + (h.vertices + 1) * sizeof(int64_t) <= mapSize
+           && h.targetsPos + h.arcs * sizeof(int32_t) <= mapSize;
+    if (ok) {
+        offs = reinterpret_cast<const int64_t*>(base + h.offsetsPos);
+        tgts = reinterpret_cast<const int32_t*>(base + h.targetsPos);
+        ok = offs[0] == 0 && static_cast<uint64_t>(offs[h.vertices]) == h.arcs;
+        for (uint64_t u = 0; ok && u < h.vertices; ++u) ok = offs[u] <= offs[u + 1];
+        for (uint64_t i = 0; ok && i < h.arcs; ++i) ok = static_cast<uint64_t>(static_cast<uint32_t>(tgts[i])) < h.vertices;
+    }
+    if (!ok) {
+        munmap(map, mapSize);
+        throw std::runtime_error("malformed graph file: " + path);
+    }
+}
+
+MappedGraph::~MappedGraph() {
+    if (map != MAP_FAILED) munmap(map, mapSize);
+}
+
+void writeGraphFile(const std::string& path, int vertices,
+                    const int32_t* endpoints, size_t edgeCount, bool directed) {
+    if (vertices < 0) throw std::runtime_error("negative vertex count");
+    for (size_t i = 0; i < 2 * edgeCount; ++i) {
+        if (endpoints[i] < 0 || endpoints[i] >= vertices)
+            throw std::runtime_error("edge endpoint out of range");
+    }
+    if (!directed) {
+        for (size_t i = 0; i < edgeCount; ++i) {
+            if (endpoints[2 * i] == endpoints[2 * i + 1])
+                throw std::runtime_error("self-loops are not supported in undirected graphs");
+        }
+    }
+
+    GraphFileHeader h{};
+    std::memcpy(h.magic, GRAPH_FILE_MAGIC, sizeof(h.magic));
+    h.version = GRAPH_FILE_VERSION;
+    h.flags = directed ? GRAPH_FILE_DIRECTED : 0;
+    h.vertices = static_cast<uint64_t>(vertices);
+    h.edges = edgeCount;
+    h.arcs = directed ? edgeCount : 2 * edgeCount;
+    h.offsetsPos = alignUp(sizeof(GraphFileHeader));
+    h.targetsPos = alignUp(h.offsetsPos + (h.vertices + 1) * sizeof(int64_t));
+    const size_t fileSize = h.targetsPos + h.arcs * sizeof(int32_t);
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) throw std::runtime_error("cannot create graph file: " + path);
+    if (ftruncate(fd, static_cast<off_t>(fileSize)) < 0) {
+        ::close(fd);
+        throw std::runtime_error("cannot size graph file: " + path);
+    }
+    void* map = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) throw std::runtime_error("cannot map graph file: " + path);
+
+    // Build the CSR arrays directly inside the mapping: count, prefix-sum, scatter
+    auto* base = static_cast<unsigned char*>(map);
+    std::memcpy(base, &h, sizeof(h));
+    auto* offsets = reinterpret_cast<int64_t*>(base + h.offsetsPos);
+    auto* targets = reinterpret_cast<int32_t*>(base + h.targetsPos);
+
+    for (size_t i = 0; i < edgeCount; ++i) {
+        ++offsets[endpoints[2 * i] + 1];
+        if (!directed) ++offsets[endpoints[2 * i + 1] + 1];
+    }
+    for (int u = 0; u < vertices; ++u) offsets[u + 1] += offsets[u];
+
+    std::vector<int64_t> fill(offsets, offsets + vertices);
+    for (size_t i = 0; i < edgeCount; ++i) {
+        int32_t u = endpoints[2 * i], v = endpoints[2 * i + 1];
+        targets[fill[u]++] = v;
+        if (!directed) targets[fill[v]++] = u;
+    }
+
+    bool synced = msync(map, fileSize, MS_SYNC) == 0;
+    munmap(map, fileSize);
+    if (!synced) throw std::runtime_error("cannot write graph file: " + path);
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Direction-optimizing breadth-first search (Beamer, Asanović, Patterson 2012).
+ *
+ * Each level is expanded in one of two directions:
+ *   top-down:  every frontier vertex scans its out-arcs for unvisited vertices
+ *   bottom-up: every unvisited vertex scans its in-arcs for a parent in the
+ *              frontier and stops at the first one found
+ * Bottom-up wins in the middle levels of low-diameter graphs, where the
+ * frontier touches most of the remaining arcs. The frontier is a queue while
+ * going top-down and a bitmap while going bottom-up. The switch uses Beamer's
+ * heuristics: go bottom-up when the frontier's arcs exceed the unexplored
+ * arcs / ALPHA, and come back once the frontier shrinks below n / BETA.
+ *
+ * The graph is read through an adaptor `g` with:
+ *   int n
+ *   int outDegree(u), int outTarget(u, i), int64_t outArc(u, i)
+ *   int inDegree(v),  int inSource(v, i),  int64_t inArc(v, i)
+ *   bool usable(int64_t arc)
+ * outArc / inArc name the arc u -> v in one numbering (any value >= 0, e.g.
+ * a residual arc index, or just the parent vertex); that value is what ends
+ * up in parent[v]. For a symmetric graph the in-arcs are the out-arcs.
+ *
+ * parent[] belongs to the caller and is not reset between runs, so one array
+ * can serve several searches (e.g. one per component):
+ *   -1 unvisited, -2 a source, otherwise the arc v was reached through.
+ */
+class HybridBFS {
+public:
+    static constexpr int64_t ALPHA = 15;
+    static constexpr int64_t BETA = 18;
+
+    /**
+     * Search from `source` until `target` is reached (target < 0: until the
+     * frontier is empty). `unexplored` is the number of arcs out of vertices
+     * not yet visited, for the direction heuristic.
+     * Returns the number of vertices visited by this run.
+     */
+    template<typename Adj>
+    int run(const Adj& g, int source, int target, int64_t* parent, int64_t unexplored) {
+        const int n = g.n;
+        queue.clear();
+        queue.push_back(source);
+        parent[source] = -2;
+        int reached = 1;
+        explored = g.outDegree(source);
+        if (source == target) return reached;
+
+        int64_t frontierArcs = explored;
+        int64_t remaining = unexplored - explored;
+        int frontierSize = 1;
+        bool bottomUp = false;
+
+        while (frontierSize > 0) {
+            if (!bottomUp && frontierArcs > remaining / ALPHA) {
+                toBitmap(n);
+                bottomUp = true;
+            } else if (bottomUp && frontierSize < n / BETA) {
+                toQueue(n);
+                bottomUp = false;
+            }
+
+            int found = 0;
+            int64_t foundArcs = 0;
+            bool hit = false;
+            if (bottomUp) {
+                std::fill(next.begin(), next.end(), 0);
+                for (int v = 0; v < n && !hit; ++v) {
+                    if (parent[v] != -1) continue;
+                    for (int i = 0, d = g.inDegree(v); i < d; ++i) {
+                        int x = g.inSource(v, i);
+                        if (!((frontier[x >> 6] >> (x & 63)) & 1)) continue;
+                        int64_t a = g.inArc(v, i);
+                        if (!g.usable(a)) continue;
+                        parent[v] = a;
+                        next[v >> 6] |= 1ULL << (v & 63);
+                        ++found;
+                        foundArcs += g.outDegree(v);
+                        hit = (v == target);
+                        break;
+                    }
+                }
+                frontier.swap(next);
+            } else {
+                nextQueue.clear();
+                for (size_t q = 0; q < queue.size() && !hit; ++q) {
+                    int u = queue[q];
+                    for (int i = 0, d = g.outDegree(u); i < d; ++i) {
+                        int v = g.outTarget(u, i);
+                        if (parent[v] != -1) continue;
+                        int64_t a = g.outArc(u, i);
+                        if (!g.usable(a)) continue;
+                        parent[v] = a;
+                        nextQueue.push_back(v);
+                        foundArcs += g.outDegree(v);
+                        if (v == target) { hit = true; break; }
+                    }
+                }
+                found = static_cast<int>(nextQueue.size());
+                queue.swap(nextQueue);
+            }
+
+            reached += found;
+            explored += foundArcs;
+            if (hit) break;
+            frontierSize = found;
+            frontierArcs = foundArcs;
+            remaining -= foundArcs;
+        }
+        return reached;
+    }
+
+    // Out-arcs of the vertices visited by the last run
+    int64_t exploredArcs() const { return explored; }
+
+private:
+    std::vector<int> queue, nextQueue;     // top-down frontier
+    std::vector<uint64_t> frontier, next;  // bottom-up frontier, one bit per vertex
+    int64_t explored = 0;
+
+    void toBitmap(int n) {
+        frontier.assign((n + 63) / 64, 0);
+        next.resize(frontier.size());
+        for (int u : queue) frontier[u >> 6] |= 1ULL << (u & 63);
+    }
+
+    void toQueue(int n) {
+        queue.clear();
+        for (int w = 0; w < (n + 63) / 64; ++w) {
+            for (uint64_t bits = frontier[w]; bits; bits &= bits - 1)
+                queue.push_back(w * 64 + __builtin_ctzll(bits));
+        }
+    }
+};
@@ -0,0 +1,175 @@
+#include "StreamingEuler.h"
+#include "GraphFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <sys/mman.h>
+
+EulerStream::EulerStream(int vertices) {
+    if (vertices > 0) grow(vertices - 1);
+}
+
+// Make room for vertex id v
+void EulerStream::grow(int v) {
+    if (v < V()) return;
+    const size_t old = parent.size();
+    // Double, but never past the largest id: v + 1 and old * 2 may not fit in an int
+    const size_t size = std::min(std::max(static_cast<size_t>(v) + 1, old * 2),
+                                 static_cast<size_t>(MAX_STREAM_VERTEX) + 1);
+    parent.resize(size);
+    for (size_t i = old; i < size; ++i) parent[i] = static_cast<int32_t>(i);
+    odd.resize((size + 63) / 64, 0);
+    touched.resize((size + 63) / 64, 0);
+}
+
+int EulerStream::find(int x) {
+    while (parent[x] != x) x = parent[x] = parent[parent[x]]; // path halving
+    return x;
+}
+
+void EulerStream::addEdge(int u, int v) {
+    if (u < 0 || v < 0 || u > MAX_STREAM_VERTEX || v > MAX_STREAM_VERTEX)
+        throw std::out_of_range("Vertex index out of bounds.");
+    grow(std::max(u, v));
+    odd[u >> 6] ^= 1ULL << (u & 63);
+    odd[v >> 6] ^= 1ULL << (v & 63);
+    touched[u >> 6] |= 1ULL << (u & 63);
+    touched[v >> 6] |= 1ULL << (v & 63);
+    int a = find(u), b = find(v);
+    if (a != b) parent[std::max(a, b)] = std::min(a, b);
+}
+
+void EulerStream::addEdges(const int32_t* endpoints, size_t count) {
+    for (size_t i = 0; i < count; ++i) addEdge(endpoints[2 * i], endpoints[2 * i + 1]);
+}
+
+int EulerStream::result() {
+    const int n = V();
+    auto bit = [](const std::vector<uint64_t>& b, int i) { return (b[i >> 6] >> (i & 63)) & 1; };
+
+    // No edges at all → trivially Eulerian Circuit
+    int root = -1;
+    for (int i = 0; i < n; ++i) {
+        if (!bit(touched, i)) continue;
+        int r = find(i);
+        if (root == -1) root = r;
+        else if (r != root) {
+            std::cout << "Graph is not connected (ignoring isolated vertices).\n";
+            return 0;
+        }
+    }
+    if (root == -1) return 2;
+
+    int oddCount = 0;
+    for (uint64_t w : odd) oddCount += __builtin_popcountll(w);
+    if (oddCount == 0) return 2;
+
+    std::cout << "Vertices with odd degree: ";
+    for (int i = 0; i < n; ++i) {
+        if (bit(odd, i)) std::cout << i << " ";
+    }
+    std::cout << std::endl;
+    return oddCount == 2 ? 1 : 0;
+}
+
+// .graph input: every undirected edge is stored as two arcs; fold it once, from its u < v arc
+static int streamGraphFile(const std::string& path, size_t chunkBytes) {
+    MappedGraph g(path);
+    if (g.directed()) throw std::runtime_error("Euler check needs an undirected graph file.");
+
+    const int n = g.V();
+    const int64_t* offsets = g.offsets();
+    const int32_t* targets = g.targets();
+    const size_t chunkArcs = std::max<size_t>(chunkBytes / sizeof(int32_t), 1);
+
+    EulerStream es(n);
+    int64_t released = 0; // arcs already dropped from the page cache hint
+    for (int u = 0; u < n; ++u) {
+        for (int64_t a = offsets[u]; a < offsets[u + 1]; ++a) {
+            int v = targets[a];
+            if (u < v) es.addEdge(u, v);
+        }
+        // Tell the kernel we are done with the targets read so far
+        if (offsets[u + 1] - released >= static_cast<int64_t>(chunkArcs)) {
+            uintptr_t from = reinterpret_cast<uintptr_t>(targets + released) & ~uintptr_t(4095);
+            uintptr_t to = reinterpret_cast<uintptr_t>(targets + offsets[u + 1]) & ~uintptr_t(4095);
+            if (to > from) madvise(reinterpret_cast<void*>(from), to - from, MADV_DONTNEED);
+            released = offsets[u + 1];
+        }
+    }
+    return es.result();
+}
+
+// Text input: parse fixed-size chunks, carrying a partial number across
+// chunk ends. Each line holds exactly two unsigned vertex ids; '#' starts
+// a comment and blank lines are skipped.
+static int streamTextFile(const std::string& path, size_t chunkBytes) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) throw std::runtime_error("cannot open " + path);
+
+    EulerStream es;
+    std::vector<char> buf(std::max<size_t>(chunkBytes, 1));
+    int32_t num = 0, ids[2] = {0, 0};
+    int found = 0; // ids on the current line
+    long long line = 1;
+    bool inNumber = false, inComment = false;
+
+    auto fail = [&](const std::string& what) {
+        std::fclose(f);
+        throw std::runtime_error(path + ":" + std::to_string(line) + ": " + what);
+    };
+    auto endNumber = [&] {
+        if (!inNumber) return;
+        if (found == 2) fail("more than two vertex ids");
+        ids[found++] = num;
+        num = 0;
+        inNumber = false;
+    };
+    auto endLine = [&] {
+        endNumber();
+        if (found == 1) fail("expected two vertex ids");
+        if (found == 2) es.addEdge(ids[0], ids[1]);
+        found = 0;
+        inComment = false;
+        ++line;
+    };
+
+    size_t got;
+    while ((got = std::fread(buf.data(), 1, buf.size(), f)) > 0) {
+        for (size_t i = 0; i < got; ++i) {
+            char c = buf[i];
+            if (c == '\n') { endLine(); continue; }
+            if (inComment) continue;
+            if (c >= '0' && c <= '9') {
+                if (num > (MAX_STREAM_VERTEX - (c - '0')) / 10) fail("vertex id too large");
+                num = num * 10 + (c - '0');
+                inNumber = true;
+            } else if (c == ' ' || c == '\t' || c == '\r') {
+                endNumber();
+            } else if (c == '#') {
+                endNumber();
+                inComment = true;
+            } else {
+                fail(std::string("unexpected character '") + c + "'");
+            }
+        }
+    }
+    endLine(); // a last line without '\n'
+    std::fclose(f);
+    return es.result();
+}
+
+int isEulerianStreaming(const std::string& path, size_t chunkBytes) {
+    // Sniff the magic to tell a .graph file from a text edge list
+    char magic[sizeof(GRAPH_FILE_MAGIC)] = {};
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) throw std::runtime_error("cannot open " + path);
+    size_t got = std::fread(magic, 1, sizeof(magic), f);
+    std::fclose(f);
+
+    if (got == sizeof(magic) && std::memcmp(magic, GRAPH_FILE_MAGIC, sizeof(magic)) == 0)
+        return streamGraphFile(path, chunkBytes);
+    return streamTextFile(path, chunkBytes);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Largest vertex id: the vertex count, id + 1, must still fit in an int
+constexpr int32_t MAX_STREAM_VERTEX = INT32_MAX - 1;
+
+/**
+ * Semi-external Euler checker for graphs larger than RAM.
+ *
+ * Edges are folded in one at a time (or a chunk at a time) and only O(V)
+ * state is kept: one degree-parity bit and one "has an edge" bit per vertex,
+ * plus a union-find over vertex ids. The edge list itself is never stored,
+ * so it can be streamed from disk.
+ *
+ * Vertex arrays grow on demand, so the vertex count need not be known up front.
+ * Ids run from 0 to MAX_STREAM_VERTEX; addEdge throws std::out_of_range otherwise.
+ */
+class EulerStream {
+public:
+    explicit EulerStream(int vertices = 0);
+
+    // Fold one undirected edge u <-> v
+    void addEdge(int u, int v);
+
+    // Fold `count` edges given as flat endpoint pairs (u0, v0, u1, v1, ...)
+    void addEdges(const int32_t* endpoints, size_t count);
+
+    // Same return values as isEulerian: 0 none, 1 path, 2 circuit.
+    // Prints the same diagnostics as isEulerian.
+    int result();
+
+    int V() const { return static_cast<int>(parent.size()); }
+
+private:
+    std::vector<int32_t> parent;  // union-find forest
+    std::vector<uint64_t> odd;    // degree parity bits
+    std::vector<uint64_t> touched; // vertex has at least one edge
+
+    void grow(int v);
+    int find(int x);
+};
+
+/**
+ * Stream a graph from disk through EulerStream.
+ * Accepts a binary .graph file (undirected) or a text edge list (exactly
+ * two unsigned ids "u v" per line, '#' comments, ids up to MAX_STREAM_VERTEX).
+ * Reads `chunkBytes` at a time.
+ * Throws std::runtime_error if the file cannot be read or a line is malformed.
+ */
+int isEulerianStreaming(const std::string& path, size_t chunkBytes = 1 << 20);
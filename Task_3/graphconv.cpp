@@ -0,0 +1,73 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <getopt.h>
+#include "GraphFile.h"
+
+using namespace std;
+
+// Converts a text edge list into the binary .graph format (see GraphFile.h).
+//
+// Input: one edge "u v" per line; blank lines and lines starting with '#' are
+// skipped. The vertex count is max id + 1 unless given with -v.
+int main(int argc, char* argv[]) {
+    bool directed = false;
+    int V = -1;
+    int opt;
+    while ((opt = getopt(argc, argv, "dv:")) != -1) {
+        switch (opt) {
+            case 'd':
+                directed = true;
+                break;
+            case 'v':
+                V = std::stoi(optarg);
+                break;
+            default:
+                cerr << "Usage: " << argv[0] << " [-d] [-v <vertices>] <edges.txt> <out.graph>\n";
+                return 1;
+        }
+    }
+    if (argc - optind != 2) {
+        cerr << "Usage: " << argv[0] << " [-d] [-v <vertices>] <edges.txt> <out.graph>\n";
+        return 1;
+    }
+
+    ifstream in(argv[optind]);
+    if (!in) {
+        cerr << "Cannot open " << argv[optind] << "\n";
+        return 1;
+    }
+
+    // Read all edges as flat endpoint pairs
+    vector<int32_t> endpoints;
+    int32_t maxId = -1;
+    string line;
+    size_t lineNo = 0;
+    while (getline(in, line)) {
+        ++lineNo;
+        if (line.empty() || line[0] == '#') continue;
+        istringstream ls(line);
+        long long u, v;
+        if (!(ls >> u >> v) || u < 0 || v < 0 || u > INT32_MAX || v > INT32_MAX) {
+            cerr << "Bad edge on line " << lineNo << ": " << line << "\n";
+            return 1;
+        }
+        endpoints.push_back(static_cast<int32_t>(u));
+        endpoints.push_back(static_cast<int32_t>(v));
+        maxId = max<int32_t>(maxId, static_cast<int32_t>(max(u, v)));
+    }
+    if (V < 0) V = maxId + 1;
+
+    try {
+        writeGraphFile(argv[optind + 1], V, endpoints.data(), endpoints.size() / 2, directed);
+    } catch (const std::exception& ex) {
+        cerr << ex.what() << "\n";
+        return 1;
+    }
+    cout << "Wrote " << argv[optind + 1] << ": " << V << " vertices, "
+         << endpoints.size() / 2 << (directed ? " directed" : " undirected") << " edges.\n";
+    return 0;
+}
@@ -4,14 +4,17 @@
 #include <set>
 #include <algorithm>
 #include "Graph.h"
+#include "GraphFile.h"
 #include "EulerChecker.h"
+#include "StreamingEuler.h"
+#include "EulerTrail.h"
 
 using namespace std;
 
 // Helper to parse CLI args
-void parseArgs(int argc, char* argv[], int& V, int& E, unsigned& seed) {
+void parseArgs(int argc, char* argv[], int& V, int& E, unsigned& seed, std::string& file, bool& stream, bool& trail) {
     int opt;
-    while ((opt = getopt(argc, argv, "v:e:s:")) != -1) {
+    while ((opt = getopt(argc, argv, "v:e:s:f:x:t")) != -1) {
         switch (opt) {
             case 'v':
                 V = std::stoi(optarg);
@@ -22,8 +25,21 @@ void parseArgs(int argc, char* argv[], int& V, int& E, unsigned& seed) {
             case 's':
                 seed = static_cast<unsigned>(std::stoul(optarg));
                 break;
+            case 'f':
+                file = optarg;
+                break;
+            case 'x':
+                file = optarg;
+                stream = true;
+                break;
+            case 't':
+                trail = true;
+                break;
             default:
-                cerr << "Usage: " << argv[0] << " -v <vertices> -e <edges> -s <seed>\n";
+                cerr << "Usage: " << argv[0] << " -v <vertices> -e <edges> -s <seed> [-t]\n";
+                cerr << "       " << argv[0] << " -f <file.graph> [-t]\n";
+                cerr << "       " << argv[0] << " -x <file.graph | edges.txt>   (stream from disk, O(V) memory)\n";
+                cerr << "  -t  also print the Euler circuit/path itself\n";
                 exit(EXIT_FAILURE);
         }
     }
@@ -52,11 +68,65 @@ void generateRandomGraph(Graph& g, int V, int E, unsigned seed) {
     }
 }
 
+// Print the checker's verdict
+static void report(int result) {
+    if (result == 2) {
+        cout << "Result: Eulerian Circuit\n";
+    } else if (result == 1) {
+        cout << "Result: Eulerian Path\n";
+    } else {
+        cout << "Result: Not Eulerian\n";
+    }
+}
+
+// Print the trail of an Eulerian graph, written out in chunks as it is built
+template<typename... GraphArgs>
+static void printTrail(int result, GraphArgs... graph) {
+    if (result == 0) return;
+    TrailWriter out([](const char* p, size_t n) { cout.write(p, n); });
+    out.text("Trail: ");
+    eulerTrail(graph..., out);
+    out.text("\n");
+}
+
 int main(int argc, char* argv[]) {
     int V = -1, E = -1;
     unsigned seed = 42;
+    std::string file;
+    bool stream = false;
+    bool trail = false;
 
-    parseArgs(argc, argv, V, E, seed);
+    parseArgs(argc, argv, V, E, seed, file, stream, trail);
+
+    // Out-of-core mode: the edge list is streamed, never held in memory
+    if (stream) {
+        try {
+            report(isEulerianStreaming(file));
+        } catch (const std::exception& ex) {
+            cerr << ex.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // Binary .graph file: mapped in O(1) and checked in place
+    if (!file.empty()) {
+        try {
+            MappedGraph g(file);
+            if (g.directed()) {
+                cerr << "Euler check needs an undirected graph file.\n";
+                return 1;
+            }
+            cout << "Mapped Graph with " << g.V() << " vertices and " << g.header().edges << " edges.\n";
+            int result = isEulerian(g);
+            report(result);
+            if (trail) printTrail(result, g.V(), g.offsets(), g.targets());
+        } catch (const std::exception& ex) {
+            cerr << ex.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
 
     if (V <= 0 || E < 0 || E > V * (V - 1) / 2) {
         cerr << "Invalid parameters. Make sure:\n";
@@ -71,13 +141,8 @@ int main(int argc, char* argv[]) {
     cout << "Generated Graph with " << V << " vertices and " << E << " edges.\n";
 
     int result = isEulerian(g);
-    if (result == 2) {
-        cout << "Result: Eulerian Circuit\n";
-    } else if (result == 1) {
-        cout << "Result: Eulerian Path\n";
-    } else {
-        cout << "Result: Not Eulerian\n";
-    }
+    report(result);
+    if (trail) printTrail(result, g.V(), g.raw());
 
     return 0;
 }
@@ -46,14 +46,52 @@ static bool sendAll(int sock, const std::string& s) {
     return true;
 }
 
-// Receive one chunk from the server (single recv).
-static bool recvOnce(int sock, std::string& out) {
-    char buf[BUFFER_SIZE];
-    int n = ::recv(sock, buf, sizeof(buf)-1, 0);
-    if (n <= 0) return false;
-    buf[n] = '\0';
-    out.assign(buf, n);
-    return true;
+// Buffered reads from the server: a reply may span many recv calls,
+// and one recv may carry the start of the next reply.
+struct Reader {
+    int sock;
+    std::string pending;
+
+    bool fill() {
+        char buf[BUFFER_SIZE];
+        ssize_t n = ::recv(sock, buf, sizeof(buf), 0);
+        if (n <= 0) return false;
+        pending.append(buf, (size_t)n);
+        return true;
+    }
+    bool line(std::string& out) {
+        size_t nl;
+        while ((nl = pending.find('\n')) == std::string::npos)
+            if (!fill()) return false;
+        out = pending.substr(0, nl);
+        pending.erase(0, nl + 1);
+        return true;
+    }
+    bool bytes(size_t n, std::string& out) {
+        while (pending.size() < n)
+            if (!fill()) return false;
+        out.append(pending, 0, n);
+        pending.erase(0, n);
+        return true;
+    }
+};
+
+// Receive one complete reply: pieces "<n>\n" + n bytes up to "0\n".
+// "!<n>\n" + text replaces a reply that failed part way; the partial
+// result is dropped and only the error is returned.
+static bool recvReply(Reader& in, std::string& out) {
+    out.clear();
+    std::string header;
+    while (in.line(header)) {
+        bool error = !header.empty() && header[0] == '!';
+        size_t n;
+        try { n = std::stoul(header.substr(error ? 1 : 0)); }
+        catch (const std::exception&) { return false; }
+        if (error) { out.clear(); return in.bytes(n, out); }
+        if (n == 0) return true;
+        if (!in.bytes(n, out)) return false;
+    }
+    return false;
 }
 
 // Print usage instructions to stderr
@@ -89,6 +127,7 @@ int main(int argc, char* argv[]) {
         std::cerr << "connect failed\n"; return 1;
     }
 
+    Reader in{sock, {}};
     std::cout << "Connected to server " << SERVER_IP << ":" << PORT << "\n";
     std::cout << "Enter algorithm name (euler|mst|scc|maxflow|hamilton), or 'quit' to exit.\n";
 
@@ -117,9 +156,9 @@ int main(int argc, char* argv[]) {
         // Send request to server
         if (!sendAll(sock, req.str())) { std::cerr << "send failed\n"; break; }
         
-        // Wait for server response and print it.
+        // Wait for the complete server response and print it.
         std::string resp;
-        if (!recvOnce(sock, resp)) { std::cerr << "server closed or recv failed\n"; break; }
+        if (!recvReply(in, resp)) { std::cerr << "server closed or recv failed\n"; break; }
         std::cout << resp;
     }
 
@@ -0,0 +1,169 @@
+#include "ConnectedComponents.h"
+#include "HybridBFS.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+constexpr int NEIGHBOR_ROUNDS = 2;        // neighbours linked before sampling
+constexpr int SAMPLES = 1024;             // vertices sampled for the largest component
+constexpr int64_t PARALLEL_WORK = 1 << 18; // vertices + arcs before threads pay off
+constexpr int BLOCK = 1024;               // vertices per scheduling block
+
+// Neighbour access for CSR arrays
+struct CSRAdj {
+    const int64_t* offsets;
+    const int* targets;
+    int degree(int u) const { return static_cast<int>(offsets[u + 1] - offsets[u]); }
+    int neighbor(int u, int i) const { return targets[offsets[u] + i]; }
+};
+
+// Neighbour access for adjacency lists
+struct ListAdj {
+    const std::vector<int>* adj;
+    int degree(int u) const { return static_cast<int>(adj[u].size()); }
+    int neighbor(int u, int i) const { return adj[u][i]; }
+};
+
+// Symmetric graph as seen by HybridBFS: in-arcs are the out-arcs, and every
+// arc is named by the root of the current search, so parent[] ends up
+// holding each vertex's component label
+template<typename Adj>
+struct ComponentArcs {
+    const Adj& g;
+    int n;
+    int root = 0;
+    int outDegree(int u) const { return g.degree(u); }
+    int outTarget(int u, int i) const { return g.neighbor(u, i); }
+    int64_t outArc(int, int) const { return root; }
+    int inDegree(int v) const { return g.degree(v); }
+    int inSource(int v, int i) const { return g.neighbor(v, i); }
+    int64_t inArc(int, int) const { return root; }
+    bool usable(int64_t) const { return true; }
+};
+
+// One thread, symmetric graph: a BFS from the smallest unvisited vertex
+// labels each component with its smallest id
+template<typename Adj>
+int bfsComponents(int n, const Adj& g, int64_t arcs, int* comp) {
+    std::vector<int64_t> parent(n, -1);
+    ComponentArcs<Adj> view{g, n};
+    HybridBFS bfs;
+    int count = 0;
+    for (int s = 0; s < n; ++s) {
+        if (parent[s] != -1) continue;
+        view.root = s;
+        bfs.run(view, s, -1, parent.data(), arcs);
+        arcs -= bfs.exploredArcs();
+        ++count;
+    }
+    for (int u = 0; u < n; ++u) comp[u] = parent[u] == -2 ? u : static_cast<int>(parent[u]);
+    return count;
+}
+
+inline int load(const int* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+
+// Hook the larger root under the smaller one with a single CAS
+void link(int u, int v, int* comp) {
+    int p1 = load(&comp[u]);
+    int p2 = load(&comp[v]);
+    while (p1 != p2) {
+        int high = std::max(p1, p2), low = std::min(p1, p2);
+        int pHigh = load(&comp[high]);
+        if (pHigh == low) break;
+        int expected = high;
+        if (pHigh == high &&
+            __atomic_compare_exchange_n(&comp[high], &expected, low, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            break;
+        p1 = load(&comp[load(&comp[high])]);
+        p2 = load(&comp[low]);
+    }
+}
+
+// Run body(u) for every vertex, blocks handed out dynamically to `threads` threads
+template<typename Body>
+void parallelFor(int n, unsigned threads, Body body) {
+    if (threads <= 1) {
+        for (int u = 0; u < n; ++u) body(u);
+        return;
+    }
+    std::atomic<int> next{0};
+    auto worker = [&] {
+        for (int lo; (lo = next.fetch_add(BLOCK)) < n;) {
+            int hi = std::min(n, lo + BLOCK);
+            for (int u = lo; u < hi; ++u) body(u);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+
+void compress(int n, int* comp, unsigned threads) {
+    parallelFor(n, threads, [&](int u) {
+        while (load(&comp[u]) != load(&comp[load(&comp[u])]))
+            __atomic_store_n(&comp[u], load(&comp[load(&comp[u])]), __ATOMIC_RELAXED);
+    });
+}
+
+// Most frequent label among a fixed pseudo-random sample of vertices
+int largestSampled(int n, const int* comp) {
+    std::unordered_map<int, int> counts;
+    uint32_t x = 2463534242u;
+    for (int i = 0; i < SAMPLES; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5; // xorshift32
+        ++counts[comp[x % static_cast<uint32_t>(n)]];
+    }
+    return std::max_element(counts.begin(), counts.end(),
+                            [](const auto& a, const auto& b) { return a.second < b.second; })->first;
+}
+
+template<typename Adj>
+int afforest(int n, const Adj& g, int64_t arcs, bool symmetric, int* comp, unsigned threads) {
+    if (n <= 0) return 0;
+    if (threads == 0) {
+        threads = (n + arcs >= PARALLEL_WORK) ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+    }
+    if (threads == 1 && symmetric) return bfsComponents(n, g, arcs, comp);
+
+    parallelFor(n, threads, [&](int u) { comp[u] = u; });
+
+    // Phase 1: link a few neighbours of every vertex
+    for (int r = 0; r < NEIGHBOR_ROUNDS; ++r) {
+        parallelFor(n, threads, [&](int u) {
+            if (g.degree(u) > r) link(u, g.neighbor(u, r), comp);
+        });
+        compress(n, comp, threads);
+    }
+
+    // Phase 2: the rest of the edges, skipping the (sampled) giant component.
+    // Its vertices' remaining edges are seen from the other endpoint's side.
+    int giant = symmetric ? largestSampled(n, comp) : -1;
+    parallelFor(n, threads, [&](int u) {
+        if (load(&comp[u]) == giant) return;
+        for (int i = NEIGHBOR_ROUNDS, d = g.degree(u); i < d; ++i) link(u, g.neighbor(u, i), comp);
+    });
+    compress(n, comp, threads);
+
+    int count = 0;
+    for (int u = 0; u < n; ++u) count += (comp[u] == u);
+    return count;
+}
+
+} // namespace
+
+int connectedComponents(int n, const int64_t* offsets, const int* targets,
+                        bool symmetric, int* label, unsigned threads) {
+    int64_t arcs = n > 0 ? offsets[n] : 0;
+    return afforest(n, CSRAdj{offsets, targets}, arcs, symmetric, label, threads);
+}
+
+int connectedComponents(int n, const std::vector<int>* adj,
+                        bool symmetric, int* label, unsigned threads) {
+    int64_t arcs = 0;
+    for (int u = 0; u < n; ++u) arcs += static_cast<int64_t>(adj[u].size());
+    return afforest(n, ListAdj{adj}, arcs, symmetric, label, threads);
+}
@@ -1,23 +1,21 @@
 #include "EulerAlgorithm.h"
 #include "Graph.h"
+#include "ConnectedComponents.h"
+#include "EulerTrail.h"
 #include <vector>
-#include <queue>
 #include <sstream>
 
 using std::vector;
 
-static void dfs(int u, const vector<int> adj[], vector<char>& seen) {
-    std::queue<int> q;
-    q.push(u);
-    seen[u] = 1;
-    while (!q.empty()) {
-        int x = q.front(); q.pop();
-        for (int v : adj[x]) if (!seen[v]) { seen[v] = 1; q.push(v); }
-    }
+std::string EulerAlgorithm::run(const Graph& g) {
+    std::string result;
+    stream(g, [&](const char* p, size_t n) { result.append(p, n); });
+    return result;
 }
 
-std::string EulerAlgorithm::run(const Graph& g) {
+void EulerAlgorithm::stream(const Graph& g, const Sink& write) {
     std::ostringstream out;
+    auto emit = [&](const std::string& text) { write(text.data(), text.size()); };
     const int n = g.V();
     const vector<int>* adj = g.raw();
 
@@ -28,16 +26,18 @@ std::string EulerAlgorithm::run(const Graph& g) {
     // No edges at all → trivially Eulerian Circuit
     if (start == -1) {
         out << "Eulerian Circuit";
-        return out.str();
+        emit(out.str());
+        return;
     }
 
     // Check connectivity (ignoring isolated vertices)
-    vector<char> seen(n, 0);
-    dfs(start, adj, seen);
+    vector<int> label(n);
+    connectedComponents(n, adj, true, label.data());
     for (int i = 0; i < n; ++i) {
-        if (!adj[i].empty() && !seen[i]) {
+        if (!adj[i].empty() && label[i] != label[start]) {
             out << "Not Eulerian\nGraph is not connected (ignoring isolated vertices).";
-            return out.str();
+            emit(out.str());
+            return;
         }
     }
 
@@ -59,6 +59,13 @@ std::string EulerAlgorithm::run(const Graph& g) {
     } else {
         out << "Not Eulerian\nVertices with odd degree: ";
         for (int u : oddVertices) out << u << ' ';
+        emit(out.str());
+        return;
     }
-    return out.str();
+
+    // Eulerian: stream the trail itself, chunk by chunk
+    TrailWriter trail(write);
+    trail.text(out.str());
+    trail.text("\nTrail: ");
+    eulerTrail(n, adj, trail);
 }
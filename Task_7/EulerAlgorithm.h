@@ -8,10 +8,14 @@
  *  - "Eulerian Circuit"
  *  - "Eulerian Path"
  *  - "Not Eulerian"
- * Also prints odd-degree vertices when circuit does not exist.
+ * Also prints odd-degree vertices when circuit does not exist, and for an
+ * Eulerian graph the trail itself ("Trail: v0 v1 ...", built by Hierholzer).
+ *
+ * stream() sends the trail in chunks as it is built; run() collects it.
  */
 class EulerAlgorithm : public GraphAlgorithm {
 public:
     std::string name() const override { return "euler"; }
     std::string run(const Graph& g) override;
+    void stream(const Graph& g, const Sink& write) override;
 };
\ No newline at end of file
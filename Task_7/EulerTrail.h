@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Buffered writer for long vertex sequences. Vertices are formatted into a
+ * fixed buffer that is handed to `flush` whenever it fills up, so a trail
+ * with tens of millions of vertices never exists as one string.
+ */
+class TrailWriter {
+public:
+    using Flush = std::function<void(const char*, size_t)>;
+
+    explicit TrailWriter(Flush flush, size_t chunkBytes = 1 << 16);
+    ~TrailWriter(); // flushes what is left
+
+    TrailWriter(const TrailWriter&) = delete;
+    TrailWriter& operator=(const TrailWriter&) = delete;
+
+    // Append raw text / one vertex (space separated)
+    void text(const std::string& s);
+    void vertex(int v);
+
+    // Hand the buffered bytes to `flush` now
+    void flush();
+
+private:
+    Flush out;
+    std::vector<char> buf;
+    size_t used;
+    bool first; // no separator before the first vertex
+};
+
+/**
+ * Euler trail by iterative Hierholzer, in O(V + E) time.
+ *
+ * The graph is undirected: every edge is stored as two arcs. Each arc is
+ * paired with its reverse (parallel edges are interchangeable, so any
+ * one-to-one pairing works), and one bit per arc marks used edges. The walk
+ * keeps an explicit stack instead of recursing, so long trails cannot
+ * overflow the call stack.
+ *
+ * The vertices are written to `out` as the walk finishes them, i.e. from the
+ * end of the trail back to its start; that is a valid trail too. For an
+ * Euler path the trail runs between the two odd-degree vertices.
+ *
+ * The graph must be Eulerian (connected apart from isolated vertices, with
+ * zero or two odd-degree vertices); classify it first. Writes nothing for a
+ * graph without edges. Returns the number of edges walked.
+ */
+int64_t eulerTrail(int n, const int64_t* offsets, const int* targets, TrailWriter& out);
+
+// Same walk over adjacency lists
+int64_t eulerTrail(int n, const std::vector<int>* adj, TrailWriter& out);
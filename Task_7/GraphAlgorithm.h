@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <functional>
 #include <string>
 #include "Graph.h"
 
@@ -18,4 +20,15 @@ public:
 
     // Run the algorithm on the given graph and return a result string.
     virtual std::string run(const Graph& g) = 0;
+
+    // Receives the result in pieces, in order.
+    using Sink = std::function<void(const char*, size_t)>;
+
+    // Run the algorithm and hand the result to `write`, possibly in several
+    // pieces. Algorithms with very large results override this so the result
+    // never has to be built as one string.
+    virtual void stream(const Graph& g, const Sink& write) {
+        std::string result = run(g);
+        write(result.data(), result.size());
+    }
 };
@@ -1,41 +1,18 @@
 #include "MSTAlgorithm.h"
+#include "ConnectedComponents.h"
 #include <vector>
-#include <stack>
 #include <sstream>
 
 /**
- * DFS over the whole graph to test connectivity.
- * We consider all vertices; if any vertex is unreachable, the graph is disconnected.
+ * Connectivity test over the whole graph with the parallel components kernel.
+ * We consider all vertices; if any vertex is in another component, the graph is disconnected.
  */
 static bool isConnectedAllVertices(const Graph& g) {
     const int n = g.V();
-    if (n == 0) return true; // vacuously connected
-    if (n == 1) return true; // single vertex
+    if (n <= 1) return true; // empty or single vertex: vacuously connected
 
-    const std::vector<int>* adj = g.raw();
-    std::vector<char> seen(n, 0);
-
-    // Find a start vertex that exists (0..n-1). For unweighted adjacency, 0 is fine.
-    int start = 0;
-    std::stack<int> st;
-    st.push(start);
-    seen[start] = 1;
-
-    while (!st.empty()) {
-        int u = st.top(); st.pop();
-        for (int v : adj[u]) {
-            if (!seen[v]) {
-                seen[v] = 1;
-                st.push(v);
-            }
-        }
-    }
-
-    // If any vertex is unseen, the graph is disconnected
-    for (int i = 0; i < n; ++i) {
-        if (!seen[i]) return false;
-    }
-    return true;
+    std::vector<int> label(n);
+    return connectedComponents(n, g.raw(), true, label.data()) == 1;
 }
 
 std::string MSTAlgorithm::run(const Graph& g) {
@@ -25,9 +25,7 @@ static bool isDirectedAlgo(const std::string& algo) {
     return (a == "scc" || a == "maxflow");
 }
 
-static void writeAll(int fd, const std::string& s) {
-    const char* p = s.c_str();
-    size_t left = s.size();
+static void writeAll(int fd, const char* p, size_t left) {
     while (left > 0) {
         ssize_t n = write(fd, p, left);
         if (n <= 0) break;
@@ -35,24 +33,55 @@ static void writeAll(int fd, const std::string& s) {
     }
 }
 
-// Keep the client connected; process multiple requests until "quit"
+static void writeAll(int fd, const std::string& s) {
+    writeAll(fd, s.data(), s.size());
+}
+
+// Replies are framed so a result of any size reads back as one unit:
+// pieces "<n>\n" + n bytes, closed by "0\n". A reply that fails after
+// pieces went out is closed by "!<n>\n" + the error text instead, telling
+// the client to drop what it received.
+static void writePiece(int fd, const std::string& data, bool error = false) {
+    writeAll(fd, (error ? "!" : "") + std::to_string(data.size()) + "\n" + data);
+}
+
+static void writeReply(int fd, const std::string& text) {
+    writePiece(fd, text);
+    writeAll(fd, "0\n");
+}
+
+// Read one '\n'-terminated line; `pending` keeps bytes past it for the next call,
+// so a request may span many recv calls and several may share one
+static bool readLine(int sock, std::string& pending, std::string& line) {
+    char buf[BUFFER_SIZE];
+    size_t nl;
+    while ((nl = pending.find('\n')) == std::string::npos) {
+        ssize_t n = recv(sock, buf, sizeof(buf), 0);
+        if (n <= 0) return false;
+        pending.append(buf, static_cast<size_t>(n));
+    }
+    line = pending.substr(0, nl);
+    pending.erase(0, nl + 1);
+    return true;
+}
+
+// Keep the client connected; process multiple requests until "quit".
+// A request is a header line "<algo> <v> <e>" followed by e edge lines.
 void handleClient(int clientSock) {
-    std::vector<char> buf(BUFFER_SIZE, 0);
+    std::string pending, line;
 
     while (true) {
-        int bytesRead = recv(clientSock, buf.data(), buf.size() - 1, 0);
-        if (bytesRead <= 0) {
+        if (!readLine(clientSock, pending, line)) {
             std::cerr << "Client disconnected or recv failed.\n";
             break;
         }
-        buf[bytesRead] = '\0';
 
-        std::istringstream input(std::string(buf.data(), bytesRead));
+        std::istringstream input(line);
 
         // First token is algorithm name
         std::string algoName;
         if (!(input >> algoName)) {
-            writeAll(clientSock, "Bad request: expected <algo> <v> <e> ...\n");
+            writeReply(clientSock, "Bad request: expected <algo> <v> <e> ...\n");
             continue; // stay connected and wait for the next request
         }
 
@@ -60,50 +89,64 @@ void handleClient(int clientSock) {
         std::string lower = algoName;
         for (auto& c : lower) c = std::tolower(static_cast<unsigned char>(c));
         if (lower == "quit") {
-            writeAll(clientSock, "bye\n");
+            writeReply(clientSock, "bye\n");
             break; // close the connection
         }
 
         int v, e;
         if (!(input >> v >> e)) {
-            writeAll(clientSock, "Bad request: expected <algo> <v> <e>\n");
+            writeReply(clientSock, "Bad request: expected <algo> <v> <e>\n");
             continue;
         }
         if (v <= 0 || e < 0) {
-            writeAll(clientSock, "Invalid graph parameters.\n");
+            writeReply(clientSock, "Invalid graph parameters.\n");
             continue;
         }
 
         Graph g(v);
         const bool directed = isDirectedAlgo(algoName);
 
-        bool bad = false;
+        // Every edge line is consumed even after a bad one, so the next request starts in step
+        std::string error;
+        bool connected = true;
         for (int i = 0; i < e; ++i) {
+            if (!readLine(clientSock, pending, line)) { connected = false; break; }
+            if (!error.empty()) continue;
+            std::istringstream edge(line);
             int u, w;
-            if (!(input >> u >> w)) {
-                writeAll(clientSock, "Bad request: not enough edges provided.\n");
-                bad = true; break;
-            }
-            if (u < 0 || u >= v || w < 0 || w >= v) {
-                writeAll(clientSock, "Invalid edge.\n");
-                bad = true; break;
+            if (!(edge >> u >> w)) {
+                error = "Bad request: not enough edges provided.\n";
+            } else if (u < 0 || u >= v || w < 0 || w >= v) {
+                error = "Invalid edge.\n";
+            } else if (directed) {
+                g.addDirectedEdge(u, w);
+            } else {
+                g.addEdge(u, w);
             }
-            if (directed) g.addDirectedEdge(u, w);
-            else g.addEdge(u, w);
         }
-        if (bad) continue;
+        if (!connected) {
+            std::cerr << "Client disconnected or recv failed.\n";
+            break;
+        }
+        if (!error.empty()) {
+            writeReply(clientSock, error);
+            continue;
+        }
 
-        // Strategy via Factory
+        // Strategy via Factory; large results (e.g. Euler trails) are streamed.
+        // Pieces are coalesced up to BUFFER_SIZE, so small results still go out in one write.
         std::string response;
         try {
             auto algo = AlgorithmFactory::create(algoName);
-            response = algo->run(g);
+            algo->stream(g, [&](const char* p, size_t n) {
+                response.append(p, n);
+                if (response.size() >= BUFFER_SIZE) { writePiece(clientSock, response); response.clear(); }
+            });
             response.push_back('\n');
+            writeReply(clientSock, response);
         } catch (const std::exception& ex) {
-            response = std::string("Error: ") + ex.what() + "\n";
+            writePiece(clientSock, std::string("Error: ") + ex.what() + "\n", true);
         }
-
-        writeAll(clientSock, response);
         // loop back and wait for the next request from the same client
     }
 
@@ -0,0 +1,159 @@
+#include "BitMatrix.h"
+#include <cstring>
+#include <immintrin.h>
+
+namespace {
+
+constexpr size_t LINE = 64; // bytes per cache line
+
+bool hasAVX2() {
+    static const bool yes = __builtin_cpu_supports("avx2");
+    return yes;
+}
+
+__attribute__((target("avx2")))
+void andNotAVX2(const uint64_t* a, const uint64_t* b, uint64_t* out, int words) {
+    for (int i = 0; i < words; i += 4) {
+        __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_load_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out + i), _mm256_andnot_si256(y, x));
+    }
+}
+
+__attribute__((target("avx2")))
+void intersectAVX2(const uint64_t* a, const uint64_t* b, uint64_t* out, int words) {
+    for (int i = 0; i < words; i += 4) {
+        __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_load_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out + i), _mm256_and_si256(x, y));
+    }
+}
+
+__attribute__((target("avx2")))
+void uniteAVX2(const uint64_t* a, const uint64_t* b, uint64_t* out, int words) {
+    for (int i = 0; i < words; i += 4) {
+        __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_load_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out + i), _mm256_or_si256(x, y));
+    }
+}
+
+// a ⊆ b  ⇔  a & ~b == 0; testc(b, a) checks exactly that
+__attribute__((target("avx2")))
+bool subsetAVX2(const uint64_t* a, const uint64_t* b, int words) {
+    for (int i = 0; i < words; i += 4) {
+        __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_load_si256(reinterpret_cast<const __m256i*>(b + i));
+        if (!_mm256_testc_si256(y, x)) return false;
+    }
+    return true;
+}
+
+// Skip zero blocks four words at a time
+__attribute__((target("avx2")))
+int firstSetAVX2(const uint64_t* a, int words) {
+    for (int i = 0; i < words; i += 4) {
+        __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i));
+        if (_mm256_testz_si256(x, x)) continue;
+        for (int w = i; w < i + 4; ++w)
+            if (a[w]) return w * 64 + __builtin_ctzll(a[w]);
+    }
+    return -1;
+}
+
+} // namespace
+
+namespace bitrow {
+
+// Rows shorter than 4 words (or not 32-byte aligned) are not from a BitMatrix;
+// they take the scalar loops
+static bool wide(const void* p, int words) {
+    return words % 4 == 0 && reinterpret_cast<uintptr_t>(p) % 32 == 0 && hasAVX2();
+}
+
+void andNot(const uint64_t* a, const uint64_t* b, uint64_t* out, int words) {
+    if (wide(a, words) && wide(b, words) && wide(out, words)) return andNotAVX2(a, b, out, words);
+    for (int i = 0; i < words; ++i) out[i] = a[i] & ~b[i];
+}
+
+void intersect(const uint64_t* a, const uint64_t* b, uint64_t* out, int words) {
+    if (wide(a, words) && wide(b, words) && wide(out, words)) return intersectAVX2(a, b, out, words);
+    for (int i = 0; i < words; ++i) out[i] = a[i] & b[i];
+}
+
+void unite(const uint64_t* a, const uint64_t* b, uint64_t* out, int words) {
+    if (wide(a, words) && wide(b, words) && wide(out, words)) return uniteAVX2(a, b, out, words);
+    for (int i = 0; i < words; ++i) out[i] = a[i] | b[i];
+}
+
+bool subset(const uint64_t* a, const uint64_t* b, int words) {
+    if (wide(a, words) && wide(b, words)) return subsetAVX2(a, b, words);
+    for (int i = 0; i < words; ++i)
+        if (a[i] & ~b[i]) return false;
+    return true;
+}
+
+int popcount(const uint64_t* a, int words) {
+    int count = 0;
+    for (int i = 0; i < words; ++i) count += __builtin_popcountll(a[i]);
+    return count;
+}
+
+int firstSet(const uint64_t* a, int words) {
+    if (wide(a, words)) return firstSetAVX2(a, words);
+    for (int i = 0; i < words; ++i)
+        if (a[i]) return i * 64 + __builtin_ctzll(a[i]);
+    return -1;
+}
+
+int nextSet(const uint64_t* a, int words, int from) {
+    int w = from >> 6;
+    if (w >= words) return -1;
+    uint64_t x = a[w] & (~0ULL << (from & 63));
+    while (!x) {
+        if (++w == words) return -1;
+        x = a[w];
+    }
+    return w * 64 + __builtin_ctzll(x);
+}
+
+} // namespace bitrow
+
+BitMatrix::BitMatrix(std::pmr::memory_resource* resource) : mr(resource) {}
+
+BitMatrix::~BitMatrix() {
+    if (bits) mr->deallocate(bits, bytes, LINE);
+}
+
+int BitMatrix::rowWords(int size) {
+    return (size + 511) / 512 * 8; // 512 bits per cache line
+}
+
+void BitMatrix::reset(int size) {
+    const int w = rowWords(size);
+    const size_t need = static_cast<size_t>(size) * w * sizeof(uint64_t);
+    if (need > bytes) {
+        if (bits) mr->deallocate(bits, bytes, LINE);
+        bits = static_cast<uint64_t*>(mr->allocate(need, LINE));
+        bytes = need;
+    }
+    n = size;
+    words = w;
+    if (need) std::memset(bits, 0, need);
+}
+
+void BitMatrix::reach(int source, const uint64_t* allowed, uint64_t* out, uint64_t* scratch) const {
+    // out = visited, scratch = frontier
+    bitrow::intersect(row(source), allowed, out, words);
+    std::memcpy(scratch, out, static_cast<size_t>(words) * sizeof(uint64_t));
+    for (int v = bitrow::firstSet(scratch, words); v != -1; v = bitrow::firstSet(scratch, words)) {
+        scratch[v >> 6] &= ~(1ULL << (v & 63));
+        // New vertices: row(v) & allowed & ~out, added to both out and the frontier
+        const uint64_t* r = row(v);
+        for (int i = 0; i < words; ++i) {
+            uint64_t fresh = r[i] & allowed[i] & ~out[i];
+            out[i] |= fresh;
+            scratch[i] |= fresh;
+        }
+    }
+}
@@ -1,49 +1,78 @@
 #include "HamiltonianAlgorithm.h"
 #include "Graph.h"
+#include "BitMatrix.h"
+#include "HamiltonianKernels.h"
 #include <vector>
 #include <sstream>
 
-// Build an adjacency matrix so we can check if an edge exists in O(1).
-static std::vector<std::vector<char>> buildAdjMatrix(const Graph& g) {
-    int n = g.V();
+// Build a bitset adjacency matrix so we can check an edge, or a whole row, at once.
+static void buildAdjMatrix(const Graph& g, BitMatrix& A) {
+    const int n = g.V();
     const std::vector<int>* adj = g.raw();
-    std::vector<std::vector<char>> A(n, std::vector<char>(n, 0));
+    A.reset(n);
     for (int u = 0; u < n; ++u) {
-        for (int v : adj[u]) A[u][v] = 1;
+        for (int v : adj[u]) A.set(u, v);
     }
-    return A;
 }
 
+// One cache line of bits; keeps the scratch rows aligned like the matrix rows
+struct alignas(64) Line { uint64_t w[8]; };
+
+// Scratch rows for the search, each A.words long
+struct SearchRows {
+    uint64_t* unplaced; // vertices not on the path yet
+    uint64_t* cand;     // one candidate row per path position
+    uint64_t* reached;  // reach() output
+    uint64_t* frontier; // reach() scratch
+};
+
+// General backtracker for graphs above HAMILTON_FIXED_MAX_VERTICES.
 // Backtracking helper: try to place vertex at position `pos` in path.
 // path[0] is fixed to 0 to avoid counting rotations of the same cycle.
-// `used[v]` marks if v is already in the path.
+// Candidates are row[last] & unplaced, computed a row at a time and
+// visited in increasing vertex order.
 // If we manage to place all vertices and there’s an edge back to the start,
 // we’ve found a Hamiltonian cycle.
-static bool backtrackHamilton(
-    const std::vector<std::vector<char>>& A,
-    std::vector<int>& path,
-    std::vector<char>& used,
-    int pos
-) {
-    const int n = (int)A.size();
+static bool backtrackHamilton(const BitMatrix& A, std::vector<int>& path, const SearchRows& r, int pos) {
+    const int n = A.n;
+    const int W = A.words;
+    const int last = path[pos - 1];
     if (pos == n) {
         // All vertices are placed, now check if the last one connects back to 0.
-        return A[path[n - 1]][path[0]] != 0;
+        return A.test(last, path[0]);
     }
 
-    // Try every possible next vertex
-    for (int v = 1; v < n; ++v) // skip 0 since it's already fixed at start
-    {
-        if (!used[v] && A[path[pos - 1]][v]) {
-            used[v] = 1;
-            path[pos] = v;
-            if (backtrackHamilton(A, path, used, pos + 1)) return true;
-            used[v] = 0; // undo choice if it didn’t work
-        }
+    // Dense connectivity check: every unplaced vertex must still be reachable
+    // from the end of the path through unplaced vertices
+    if (n - pos >= HAMILTON_PRUNE_MIN_LEFT) {
+        A.reach(last, r.unplaced, r.reached, r.frontier);
+        if (!bitrow::subset(r.unplaced, r.reached, W)) return false;
+    }
+
+    uint64_t* cand = r.cand + static_cast<size_t>(pos) * W;
+    bitrow::intersect(A.row(last), r.unplaced, cand, W);
+    for (int v = bitrow::firstSet(cand, W); v != -1; v = bitrow::nextSet(cand, W, v + 1)) {
+        r.unplaced[v >> 6] &= ~(1ULL << (v & 63));
+        path[pos] = v;
+        if (backtrackHamilton(A, path, r, pos + 1)) return true;
+        r.unplaced[v >> 6] |= 1ULL << (v & 63); // undo choice if it didn’t work
     }
     return false;
 }
 
+// Set up the scratch rows and run the general backtracker
+static bool searchGeneral(const BitMatrix& A, std::vector<int>& path) {
+    const int n = A.n;
+    const size_t W = A.words;
+    std::vector<Line> scratch(W / 8 * (n + 3), Line{});
+    uint64_t* base = scratch.data()->w;
+    SearchRows rows{base, base + W, base + W * (n + 1), base + W * (n + 2)};
+    for (int v = 1; v < n; ++v) rows.unplaced[v >> 6] |= 1ULL << (v & 63);
+
+    path[0] = 0; // Fix start to 0 (break rotational symmetry)
+    return backtrackHamilton(A, path, rows, 1);
+}
+
 std::string HamiltonianAlgorithm::run(const Graph& g) {
     std::ostringstream out;
     const int n = g.V();
@@ -51,7 +80,8 @@ std::string HamiltonianAlgorithm::run(const Graph& g) {
     if (n == 0) { out << "No Hamiltonian circuit (empty graph)\n"; return out.str(); }
     if (n == 1) { out << "Hamiltonian circuit: 0 -> 0\n"; return out.str(); }
 
-    auto A = buildAdjMatrix(g);
+    BitMatrix A;
+    buildAdjMatrix(g, A);
 
     // For an undirected Hamiltonian cycle, every vertex should have degree >= 2 (this isn’t a complete test).
     {
@@ -68,12 +98,11 @@ std::string HamiltonianAlgorithm::run(const Graph& g) {
     }
 
     std::vector<int> path(n, -1);
-    std::vector<char> used(n, 0);
-
-    path[0] = 0; // Fix start to 0 (break rotational symmetry)
-    used[0] = 1;
+    bool found = n <= HAMILTON_FIXED_MAX_VERTICES
+        ? hamiltonFixedWidth(A, path.data()) // masks of 1, 2 or 4 words
+        : searchGeneral(A, path);
 
-    if (backtrackHamilton(A, path, used, 1)) {
+    if (found) {
         out << "Hamiltonian circuit: ";
         for (int i = 0; i < n; ++i) {
             out << path[i] << " ";
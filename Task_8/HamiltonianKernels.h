@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+#include "BitMatrix.h"
+
+// Below this many unplaced vertices the search skips the reachability check
+constexpr int HAMILTON_PRUNE_MIN_LEFT = 8;
+
+// Largest graph handled by the fixed-width kernels
+constexpr int HAMILTON_FIXED_MAX_VERTICES = 256;
+
+/**
+ * Vertex set of exactly W 64-bit words, held by value. For W = 1 it is a
+ * plain uint64_t, so the search state of a small graph stays in registers.
+ */
+template<int W>
+struct VertexMask {
+    uint64_t w[W];
+
+    static VertexMask none() {
+        VertexMask m{};
+        return m;
+    }
+    static VertexMask load(const uint64_t* row) {
+        VertexMask m;
+        for (int i = 0; i < W; ++i) m.w[i] = row[i];
+        return m;
+    }
+
+    bool any() const {
+        uint64_t x = 0;
+        for (int i = 0; i < W; ++i) x |= w[i];
+        return x != 0;
+    }
+    bool subsetOf(const VertexMask& o) const {
+        uint64_t x = 0;
+        for (int i = 0; i < W; ++i) x |= w[i] & ~o.w[i];
+        return x == 0;
+    }
+    void set(int v) { w[v >> 6] |= 1ULL << (v & 63); }
+    void clear(int v) { w[v >> 6] &= ~(1ULL << (v & 63)); }
+
+    // Remove and return the lowest member (the set must not be empty)
+    int popFirst() {
+        for (int i = 0;; ++i) {
+            if (w[i]) {
+                int v = i * 64 + __builtin_ctzll(w[i]);
+                w[i] &= w[i] - 1;
+                return v;
+            }
+        }
+    }
+
+    VertexMask operator&(const VertexMask& o) const {
+        VertexMask m;
+        for (int i = 0; i < W; ++i) m.w[i] = w[i] & o.w[i];
+        return m;
+    }
+    VertexMask andNot(const VertexMask& o) const {
+        VertexMask m;
+        for (int i = 0; i < W; ++i) m.w[i] = w[i] & ~o.w[i];
+        return m;
+    }
+    VertexMask& operator|=(const VertexMask& o) {
+        for (int i = 0; i < W; ++i) w[i] |= o.w[i];
+        return *this;
+    }
+};
+
+/**
+ * Hamiltonian cycle search for graphs with at most 64 * W vertices.
+ *
+ * Same search as the general backtracker (path starts at 0, candidates in
+ * increasing vertex order, reachability pruning), but adjacency rows and
+ * the unplaced set are fixed-width masks. The loops over words unroll at
+ * compile time, the unplaced set is passed by value instead of being undone
+ * after each try, and the rows of a 256-vertex graph take 8 KB, so the
+ * search stays in L1.
+ */
+template<int W>
+class FixedWidthHamilton {
+public:
+    explicit FixedWidthHamilton(const BitMatrix& A) : n(A.n) {
+        for (int u = 0; u < n; ++u) adj[u] = VertexMask<W>::load(A.row(u));
+    }
+
+    // Fill path[0..n) with a Hamiltonian cycle through 0, if there is one
+    bool find(int* path) {
+        out = path;
+        out[0] = 0;
+        VertexMask<W> unplaced = VertexMask<W>::none();
+        for (int v = 1; v < n; ++v) unplaced.set(v);
+        return search(1, 0, unplaced);
+    }
+
+private:
+    int n;
+    int* out = nullptr;
+    VertexMask<W> adj[64 * W];
+
+    bool search(int pos, int last, VertexMask<W> unplaced) const {
+        if (pos == n) return adj[last].w[0] & 1; // edge back to 0
+        if (n - pos >= HAMILTON_PRUNE_MIN_LEFT && !unplaced.subsetOf(reach(last, unplaced))) return false;
+
+        for (VertexMask<W> cand = adj[last] & unplaced; cand.any();) {
+            int v = cand.popFirst();
+            out[pos] = v;
+            VertexMask<W> rest = unplaced;
+            rest.clear(v);
+            if (search(pos + 1, v, rest)) return true;
+        }
+        return false;
+    }
+
+    // Vertices reachable from `from` through `allowed` (bit-parallel BFS)
+    VertexMask<W> reach(int from, const VertexMask<W>& allowed) const {
+        VertexMask<W> seen = adj[from] & allowed;
+        for (VertexMask<W> frontier = seen; frontier.any();) {
+            VertexMask<W> fresh = (adj[frontier.popFirst()] & allowed).andNot(seen);
+            seen |= fresh;
+            frontier |= fresh;
+        }
+        return seen;
+    }
+};
+
+/**
+ * Run the kernel whose width fits A.n (64, 128 or 256 vertices).
+ * A.n must be at most HAMILTON_FIXED_MAX_VERTICES.
+ */
+inline bool hamiltonFixedWidth(const BitMatrix& A, int* path) {
+    if (A.n <= 64) return FixedWidthHamilton<1>(A).find(path);
+    if (A.n <= 128) return FixedWidthHamilton<2>(A).find(path);
+    return FixedWidthHamilton<4>(A).find(path);
+}
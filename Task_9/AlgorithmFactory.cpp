@@ -5,11 +5,93 @@
 #include "MaxFlowAlgorithm.h"
 #include "HamiltonianAlgorithm.h"
 #include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Options = GraphAlgorithm::Options;
+
+constexpr double PUSH_RELABEL_VISITS_PER_ARC = 16; // rough allowance for rounds and global relabels, not tuned
+constexpr double POSA_VISITS_PER_ARC = 1024;       // both restarts at full budget
+constexpr double COST_CAP = 1e300;                 // keeps exponential estimates finite
+
+double cores() { return std::max(1u, std::thread::hardware_concurrency()); }
+
+// Flows a maxflow request asks for
+double flowCount(const Options& opts) {
+    auto it = opts.find("pairs");
+    return it == opts.end() ? 1 : 1 + std::count(it->second.begin(), it->second.end(), ',');
+}
+
+// One augmenting-path flow: a search per unit of flow, and unit-capacity
+// flows rarely exceed the average degree
+double augmentingCost(const GraphStats& g) {
+    return std::max(1.0, std::min(g.avgDegree, g.vertices - 1.0)) * (g.vertices + g.arcs);
+}
+
+// Backtracking branches on the free neighbours of the path's end; on dense
+// graphs nearly every branch completes, so the first ones find a cycle
+double backtrackCost(const GraphStats& g) {
+    const double branch = std::max(1.0, g.avgDegree * (1 - g.density));
+    return std::min(COST_CAP, g.vertices * std::pow(branch, g.vertices));
+}
+
+std::map<std::string, std::vector<AlgorithmVariant>>& registry() {
+    static std::map<std::string, std::vector<AlgorithmVariant>> variants = {
+        {"maxflow", {
+            {"ek", {{"method", "auto"}, {"engine", "ek"}},
+             [](const GraphStats& g, const Options& o) { return flowCount(o) * augmentingCost(g); }},
+            {"pushrelabel", {{"method", "auto"}, {"engine", "pushrelabel"}},
+             [](const GraphStats& g, const Options& o) {
+                 return flowCount(o) * PUSH_RELABEL_VISITS_PER_ARC * (g.vertices + g.arcs) / cores();
+             }},
+            // n - 1 flows spread over the cores, then every pair is a tree walk
+            {"tree", {{"method", "tree"}},
+             [](const GraphStats& g, const Options&) {
+                 return g.symmetric ? (g.vertices - 1.0) * augmentingCost(g) / cores() : VARIANT_NOT_APPLICABLE;
+             }},
+        }},
+        {"hamilton", {
+            // Rotations almost always succeed once the average degree passes
+            // ln n (where random graphs become Hamiltonian); below that, count
+            // on falling back to the exact search half of the time
+            {"posa", {{"strategy", "posa"}},
+             [](const GraphStats& g, const Options&) {
+                 if (!g.symmetric || g.vertices <= 2) return VARIANT_NOT_APPLICABLE;
+                 const double fallback = g.avgDegree >= std::log(g.vertices) ? 0 : 0.5;
+                 return std::min(COST_CAP, POSA_VISITS_PER_ARC * (g.vertices + g.arcs) + fallback * backtrackCost(g));
+             }},
+            {"exact", {{"strategy", "exact"}},
+             [](const GraphStats& g, const Options&) { return backtrackCost(g); }},
+            {"dp", {{"strategy", "dp"}},
+             [](const GraphStats& g, const Options&) {
+                 return g.vertices <= HAMILTON_DP_MAX_VERTICES ? std::ldexp(g.vertices, g.vertices - 1)
+                                                               : VARIANT_NOT_APPLICABLE;
+             }},
+        }},
+    };
+    return variants;
+}
+
+// The request sets none of the variant's options to something else
+bool compatible(const AlgorithmVariant& v, const Options& opts) {
+    for (const auto& [key, value] : v.options) {
+        auto it = opts.find(key);
+        if (it != opts.end() && it->second != value) return false;
+    }
+    return true;
+}
+
+} // namespace
 
 std::unique_ptr<GraphAlgorithm> AlgorithmFactory::create(const std::string& raw) {
     std::string name = raw;
-    
+
     // normalize to lowercase
     std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c){ return std::tolower(c); });
 
@@ -19,4 +101,90 @@ std::unique_ptr<GraphAlgorithm> AlgorithmFactory::create(const std::string& raw)
     if (name == "hamilton")  return std::make_unique<HamiltonianAlgorithm>();
 
     throw std::invalid_argument("Unknown algorithm: " + raw);
-}
\ No newline at end of file
+}
+
+std::string AlgorithmFactory::parse(const std::string& request, GraphAlgorithm::Options& opts) {
+    std::istringstream in(request);
+    std::string name, word;
+    in >> name;
+    while (in >> word) {
+        size_t eq = word.find('=');
+        if (eq == std::string::npos) opts[word] = "1";
+        else opts[word.substr(0, eq)] = word.substr(eq + 1);
+    }
+    return name;
+}
+
+void AlgorithmFactory::addVariant(const std::string& algorithm, AlgorithmVariant v) {
+    registry()[algorithm].push_back(std::move(v));
+}
+
+PlanResult AlgorithmFactory::select(const std::string& algorithm, GraphContext& ctx, GraphAlgorithm::Options& opts) {
+    PlanResult plan;
+    plan.algorithm = algorithm;
+    plan.stats = ctx.stats();
+
+    auto wanted = opts.find("variant");
+    auto found = registry().find(algorithm);
+    if (found == registry().end() || found->second.empty()) {
+        if (wanted != opts.end()) throw std::invalid_argument(algorithm + " has no variants");
+        return plan;
+    }
+
+    const AlgorithmVariant* best = nullptr;
+    double bestCost = 0;
+    for (const AlgorithmVariant& v : found->second) {
+        double cost = compatible(v, opts) ? v.cost(plan.stats, opts) : VARIANT_NOT_APPLICABLE;
+        plan.costs.emplace_back(v.name, cost);
+        if (wanted != opts.end()) {
+            if (v.name != wanted->second) continue;
+            if (cost < 0) throw std::invalid_argument(algorithm + " variant " + v.name + " does not apply here");
+            best = &v;
+        } else if (cost >= 0 && (!best || cost < bestCost)) {
+            best = &v;
+            bestCost = cost;
+        }
+    }
+    if (wanted != opts.end() && !best)
+        throw std::invalid_argument("unknown " + algorithm + " variant " + wanted->second);
+    if (!best) return plan; // the request's own options pin the implementation
+
+    plan.variant = best->name;
+    plan.requested = wanted != opts.end();
+    for (const auto& option : best->options) opts.insert(option);
+    return plan;
+}
+
+double AlgorithmFactory::estimateCost(const std::string& algorithm, GraphContext& ctx,
+                                      const GraphAlgorithm::Options& opts) {
+    const GraphStats& g = ctx.stats();
+    if (opts.count("explain")) return 0;
+
+    auto found = registry().find(algorithm);
+    if (found == registry().end() || found->second.empty()) return g.vertices + g.arcs;
+
+    GraphAlgorithm::Options chosen = opts;
+    PlanResult plan;
+    try {
+        plan = select(algorithm, ctx, chosen);
+    } catch (const std::invalid_argument&) {
+        return 0; // answered with an error straight away
+    }
+    double cost = 0;
+    for (size_t i = 0; i < plan.costs.size(); ++i) {
+        if (plan.costs[i].first == plan.variant) return plan.costs[i].second;
+        cost = std::max(cost, found->second[i].cost(g, opts));
+    }
+    return cost;
+}
+
+AlgorithmResult AlgorithmFactory::dispatch(GraphAlgorithm& alg, GraphContext& ctx, GraphAlgorithm::Options opts) {
+    PlanResult plan;
+    try {
+        plan = select(alg.name(), ctx, opts);
+    } catch (const std::invalid_argument& e) {
+        return ErrorResult{std::string("Error: ") + e.what() + "\n"};
+    }
+    if (opts.count("explain")) return plan;
+    return alg.compute(ctx, opts);
+}
@@ -1,9 +1,55 @@
 #pragma once
+#include <functional>
 #include <memory>
 #include <string>
 #include "GraphAlgorithm.h"
 
+// Marks a variant that cannot run on the graph or request at hand
+constexpr double VARIANT_NOT_APPLICABLE = -1;
+
+/**
+ * One interchangeable implementation of an algorithm: the options that
+ * select it (e.g. maxflow engine=pushrelabel) and a rough cost model over
+ * the graph's shape statistics and the request's own options. Costs are in
+ * arc visits and only compared with each other.
+ */
+struct AlgorithmVariant {
+    std::string name;
+    GraphAlgorithm::Options options;
+    std::function<double(const GraphStats&, const GraphAlgorithm::Options&)> cost;
+};
+
 class AlgorithmFactory {
 public:
     static std::unique_ptr<GraphAlgorithm> create(const std::string& name);
+
+    // Split a request line "name key=value flag ..." into the algorithm name
+    // and its options (a bare flag gets the value "1")
+    static std::string parse(const std::string& request, GraphAlgorithm::Options& opts);
+
+    // Register another variant of `algorithm`; the built-in variants are
+    // registered on first use. Not synchronised with select(): call at start-up.
+    static void addVariant(const std::string& algorithm, AlgorithmVariant v);
+
+    /**
+     * Pick the variant of `algorithm` for this graph and request and merge
+     * its options into `opts`.
+     *
+     * The cheapest applicable variant wins. Options the request sets itself
+     * rule out variants that would change them; "variant=<name>" names one
+     * outright. Throws std::invalid_argument for an unknown or inapplicable
+     * name. An algorithm without variants runs as requested.
+     */
+    static PlanResult select(const std::string& algorithm, GraphContext& ctx, GraphAlgorithm::Options& opts);
+
+    /**
+     * Estimated work of a request, in the variants' units, before it runs:
+     * the cost of the variant select() would pick, the dearest variant when
+     * the request pins the implementation itself, and one pass over the
+     * graph for algorithms without variants.
+     */
+    static double estimateCost(const std::string& algorithm, GraphContext& ctx, const GraphAlgorithm::Options& opts);
+
+    // select() and compute(); for an "explain" request, the plan itself
+    static AlgorithmResult dispatch(GraphAlgorithm& alg, GraphContext& ctx, GraphAlgorithm::Options opts);
 };
@@ -0,0 +1,188 @@
+#include "AlgorithmResult.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <endian.h>
+
+namespace {
+
+constexpr size_t PIECE_BYTES = 1 << 16; // hand the output to the sink at this size
+
+// Buffers encoded output and passes it on in pieces
+class PieceWriter {
+public:
+    explicit PieceWriter(const ResultSink& s) : sink(s) {}
+
+    void text(const char* s) { buf += s; spill(); }
+    void text(const std::string& s) { buf += s; spill(); }
+    void number(int64_t x) {
+        char tmp[24];
+        buf.append(tmp, std::to_chars(tmp, tmp + sizeof(tmp), x).ptr);
+        spill();
+    }
+    void real(double x) {
+        char tmp[32];
+        buf.append(tmp, std::snprintf(tmp, sizeof(tmp), "%.3g", x));
+        spill();
+    }
+
+    // Binary fields, network byte order
+    void u8(uint8_t x) { raw(&x, 1); }
+    void i32(int32_t x) { uint32_t be = htobe32(static_cast<uint32_t>(x)); raw(&be, 4); }
+    void i64(int64_t x) { uint64_t be = htobe64(static_cast<uint64_t>(x)); raw(&be, 8); }
+
+    void flush() {
+        if (!buf.empty()) sink(buf.data(), buf.size());
+        buf.clear();
+    }
+
+private:
+    const ResultSink& sink;
+    std::string buf;
+
+    void raw(const void* p, size_t n) { buf.append(static_cast<const char*>(p), n); spill(); }
+    void spill() { if (buf.size() >= PIECE_BYTES) flush(); }
+};
+
+// Human-readable form, exactly what the algorithms used to format themselves
+struct TextEncoder {
+    PieceWriter& w;
+
+    void operator()(const ErrorResult& r) { w.text(r.message); }
+
+    void operator()(const MSTResult& r) {
+        if (r.vertices == 0) { w.text("MST weight (unit): 0  (empty graph)\n"); return; }
+        if (!r.connected) {
+            w.text("MST does not exist: graph is disconnected (spanning tree requires one connected component).\n");
+            return;
+        }
+        w.text("MST weight (unit): "); w.number(r.weight); w.text("\n");
+    }
+
+    void operator()(const SCCResult& r) {
+        if (r.view == SCCResult::Ids) { // one id per vertex, in vertex order
+            for (int u = 0; u < r.vertices; ++u) {
+                w.number(r.scc->comp[u]);
+                if (u + 1 != r.vertices) w.text(" ");
+            }
+            w.text("\n");
+            return;
+        }
+        if (!r.scc) { w.text("SCC count: 0 (empty graph)"); return; }
+        const SCCDecomposition& s = *r.scc;
+        w.text("SCC count: "); w.number(s.count); w.text("\n");
+        if (r.view == SCCResult::Count) return;
+        for (int c = 0; c < s.count; ++c) {
+            w.text("SCC "); w.number(c); w.text(": ");
+            for (int j = s.start[c]; j < s.start[c + 1]; ++j) {
+                w.number(s.members[j]);
+                if (j + 1 != s.start[c + 1]) w.text(" ");
+            }
+            w.text("\n");
+        }
+    }
+
+    void operator()(const FlowResult& r) {
+        w.text("Max flow ("); w.number(r.source); w.text("->"); w.number(r.sink);
+        w.text(", unit capacities): "); w.number(r.value); w.text("\n");
+    }
+
+    void operator()(const FlowTableResult& r) {
+        for (const FlowResult& f : r.flows) (*this)(f);
+    }
+
+    void operator()(const CycleResult& r) {
+        if (r.vertices == 0) { w.text("No Hamiltonian circuit (empty graph)\n"); return; }
+        if (!r.found) { w.text("No Hamiltonian circuit\n"); return; }
+        if (r.vertices == 1) { w.text("Hamiltonian circuit: 0 -> 0\n"); return; }
+        w.text("Hamiltonian circuit: ");
+        for (int v : r.cycle) { w.number(v); w.text(" "); }
+        w.number(r.cycle[0]); w.text("\n"); // close the cycle by returning to the start
+    }
+
+    void operator()(const PlanResult& r) {
+        w.text("Plan for "); w.text(r.algorithm); w.text(": ");
+        if (r.variant.empty()) w.text(r.costs.empty() ? "single implementation\n" : "fixed by the request's options\n");
+        else { w.text("variant "); w.text(r.variant); w.text(r.requested ? " (requested)\n" : " (lowest cost)\n"); }
+        const GraphStats& g = r.stats;
+        w.text("  graph: V="); w.number(g.vertices); w.text(" arcs="); w.number(g.arcs);
+        w.text(" density="); w.real(g.density); w.text(" avg degree="); w.real(g.avgDegree);
+        w.text(" max degree="); w.number(g.maxDegree); w.text(" skew="); w.real(g.degreeSkew);
+        w.text(g.symmetric ? " undirected\n" : " directed\n");
+        for (const auto& [name, cost] : r.costs) {
+            w.text("  "); w.text(name); w.text(": ");
+            if (cost < 0) w.text("n/a");
+            else { w.text("cost "); w.real(cost); }
+            w.text("\n");
+        }
+    }
+};
+
+// Compact form; the layout is documented in AlgorithmResult.h
+struct BinaryEncoder {
+    PieceWriter& w;
+
+    void operator()(const ErrorResult& r) { string(r.message); }
+
+    void operator()(const MSTResult& r) {
+        w.i32(r.vertices); w.u8(r.connected); w.i64(r.weight);
+    }
+
+    void operator()(const SCCResult& r) {
+        const bool ids = r.scc && r.view != SCCResult::Count;
+        w.i32(r.scc ? r.scc->count : 0);
+        w.i32(ids ? r.vertices : 0);
+        if (ids) for (int u = 0; u < r.vertices; ++u) w.i32(r.scc->comp[u]);
+    }
+
+    void operator()(const FlowResult& r) {
+        w.i32(r.source); w.i32(r.sink); w.i64(r.value);
+    }
+
+    void operator()(const FlowTableResult& r) {
+        w.i32(static_cast<int32_t>(r.flows.size()));
+        for (const FlowResult& f : r.flows) (*this)(f);
+    }
+
+    void operator()(const CycleResult& r) {
+        w.u8(r.found);
+        w.i32(static_cast<int32_t>(r.cycle.size()));
+        for (int v : r.cycle) w.i32(v);
+    }
+
+    void operator()(const PlanResult& r) {
+        string(r.algorithm);
+        string(r.variant);
+        w.u8(r.requested);
+        w.i32(static_cast<int32_t>(r.costs.size()));
+        for (const auto& [name, cost] : r.costs) {
+            string(name);
+            w.i64(cost < 0 ? -1 : static_cast<int64_t>(std::min(cost, 9.2e18)));
+        }
+        w.i32(r.stats.vertices); w.i64(r.stats.arcs); w.i32(r.stats.maxDegree); w.u8(r.stats.symmetric);
+    }
+
+    void string(const std::string& s) {
+        w.i32(static_cast<int32_t>(s.size()));
+        w.text(s);
+    }
+};
+
+} // namespace
+
+void encodeResult(const AlgorithmResult& r, Encoding enc, const ResultSink& write) {
+    PieceWriter w(write);
+    if (enc == Encoding::Binary) {
+        w.u8(static_cast<uint8_t>(r.index()));
+        std::visit(BinaryEncoder{w}, r);
+    } else {
+        std::visit(TextEncoder{w}, r);
+    }
+    w.flush();
+}
+
+std::string encodeResult(const AlgorithmResult& r, Encoding enc) {
+    std::string out;
+    encodeResult(r, enc, [&](const char* p, size_t n) { out.append(p, n); });
+    return out;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "GraphContext.h"
+
+/**
+ * Typed results of the graph algorithms.
+ *
+ * Algorithms return one of these structs instead of a formatted string; the
+ * response stage encodes it for the client, either as the human-readable
+ * text the server has always sent or as a compact binary record. A program
+ * that only wants the numbers never pays for formatting.
+ *
+ * Binary encoding: a one-byte tag (the variant index) followed by the fields
+ * in network byte order:
+ *   0 error  u32 length, message bytes
+ *   1 mst    i32 vertices, u8 connected, i64 weight
+ *   2 scc    i32 count, i32 k, k x i32 component id per vertex (k = 0 for view Count)
+ *   3 flow   i32 source, i32 sink, i64 value
+ *   4 cycle  u8 found, i32 k, k x i32 vertices of the cycle (start not repeated)
+ *   5 flows  i32 k, k x (i32 source, i32 sink, i64 value)
+ *   6 plan   i32 length, algorithm; i32 length, variant; u8 requested;
+ *            i32 k, k x (i32 length, name, i64 cost or -1);
+ *            i32 vertices, i64 arcs, i32 max degree, u8 symmetric
+ */
+
+// Part of every result store key: bump it whenever an algorithm or an
+// encoder changes what a request's response looks like, so stored results
+// from older servers are no longer served
+constexpr uint32_t RESULT_FORMAT_VERSION = 3;
+
+struct ErrorResult {
+    std::string message; // sent as is in text form
+};
+
+// Unit-weight spanning tree
+struct MSTResult {
+    int vertices = 0;
+    bool connected = false;
+    int64_t weight = 0;
+};
+
+// Strongly connected components, as a view of the context's decomposition
+struct SCCResult {
+    enum View { List, Count, Ids }; // text: listing, count line, decimal ids
+    int vertices = 0;
+    const SCCDecomposition* scc = nullptr; // owned by the GraphContext; null for an empty graph
+    View view = List;
+};
+
+struct FlowResult {
+    int source = 0;
+    int sink = 0;
+    int64_t value = 0;
+};
+
+// Several s-t flows from one request, in request order
+struct FlowTableResult {
+    std::vector<FlowResult> flows;
+};
+
+// Hamiltonian circuit
+struct CycleResult {
+    int vertices = 0;
+    bool found = false;
+    std::vector<int> cycle; // starts at 0
+};
+
+// Variant selection for an "explain" request: what would run, and why
+struct PlanResult {
+    std::string algorithm;
+    std::string variant;    // empty when the algorithm has a single implementation
+    bool requested = false; // named by the request rather than picked by cost
+    std::vector<std::pair<std::string, double>> costs; // every variant's estimate, -1 if it cannot run
+    GraphStats stats;
+};
+
+using AlgorithmResult = std::variant<ErrorResult, MSTResult, SCCResult, FlowResult, CycleResult, FlowTableResult,
+                                     PlanResult>;
+
+enum class Encoding { Text, Binary };
+
+// Receives an encoded result in pieces, in order.
+using ResultSink = std::function<void(const char*, size_t)>;
+
+// Encode `r`, handing it to `write` in pieces of at most about 64 KiB
+void encodeResult(const AlgorithmResult& r, Encoding enc, const ResultSink& write);
+
+// Encode `r` into one string
+std::string encodeResult(const AlgorithmResult& r, Encoding enc);
@@ -0,0 +1,30 @@
+#include "Arena.h"
+
+RequestArena::RequestArena(size_t sizeHint)
+    : pool(sizeHint ? sizeHint : 1024, std::pmr::new_delete_resource()), bytes(0) {}
+
+size_t RequestArena::allocated() const {
+    std::lock_guard<std::mutex> lk(mtx);
+    return bytes;
+}
+
+size_t RequestArena::estimate(int V, int E) {
+    if (V < 0) V = 0;
+    if (E < 0) E = 0;
+    // Per vertex: list header plus CSR/transpose offsets and component ids.
+    // Per edge: both directions in the lists, CSR and transpose.
+    return static_cast<size_t>(V) * 96 + static_cast<size_t>(E) * 32;
+}
+
+void* RequestArena::do_allocate(size_t n, size_t align) {
+    std::lock_guard<std::mutex> lk(mtx);
+    bytes += n;
+    return pool.allocate(n, align);
+}
+
+// Memory is only given back when the whole arena goes away
+void RequestArena::do_deallocate(void*, size_t, size_t) {}
+
+bool RequestArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
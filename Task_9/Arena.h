@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+/**
+ * Request-scoped monotonic arena.
+ *
+ * Backs the adjacency lists of an uploaded graph and the artifacts derived
+ * from it (CSR, transpose, components, ...). Allocation is a pointer bump,
+ * individual deallocations are no-ops, and everything is returned in one go
+ * when the arena is destroyed, so handler threads stop contending on malloc
+ * for per-vertex vectors.
+ *
+ * Allocation is mutex-guarded because the workers of an "all" request may
+ * build different artifacts of the same graph at the same time.
+ */
+class RequestArena : public std::pmr::memory_resource {
+public:
+    // `sizeHint` sizes the first upstream block (0 → library default)
+    explicit RequestArena(size_t sizeHint = 0);
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    // Bytes handed out so far
+    size_t allocated() const;
+
+    // Rough arena size for a graph with V vertices and E edges
+    static size_t estimate(int V, int E);
+
+private:
+    std::pmr::monotonic_buffer_resource pool;
+    mutable std::mutex mtx;
+    size_t bytes;
+
+    void* do_allocate(size_t n, size_t align) override;
+    void do_deallocate(void* p, size_t n, size_t align) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+/**
+ * Word-parallel operations on bit rows of `words` 64-bit words.
+ *
+ * Rows handed out by BitMatrix are 64-byte aligned and padded to whole cache
+ * lines, so `words` is a multiple of 8 and the AVX2 paths need no tail
+ * handling. The AVX2 versions are picked at run time on CPUs that have it;
+ * other machines use the plain 64-bit loops.
+ */
+namespace bitrow {
+    void andNot(const uint64_t* a, const uint64_t* b, uint64_t* out, int words); // out = a & ~b
+    void intersect(const uint64_t* a, const uint64_t* b, uint64_t* out, int words); // out = a & b
+    void unite(const uint64_t* a, const uint64_t* b, uint64_t* out, int words); // out = a | b
+    bool subset(const uint64_t* a, const uint64_t* b, int words); // a ⊆ b
+    int popcount(const uint64_t* a, int words);
+    int firstSet(const uint64_t* a, int words); // lowest set bit, -1 if none
+    int nextSet(const uint64_t* a, int words, int from); // lowest set bit >= from, -1 if none
+}
+
+/**
+ * Dense adjacency matrix, one bit per (u, v) pair.
+ *
+ * One contiguous 64-byte aligned allocation; every row starts on a cache
+ * line and is padded with zero bits to a whole number of lines.
+ */
+class BitMatrix {
+public:
+    int n = 0;
+    int words = 0; // 64-bit words per row (multiple of 8)
+
+    explicit BitMatrix(std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+    ~BitMatrix();
+
+    BitMatrix(const BitMatrix&) = delete;
+    BitMatrix& operator=(const BitMatrix&) = delete;
+
+    // Resize to size x size, all bits clear
+    void reset(int size);
+
+    // Words per row needed for `size` columns, rounded up to whole cache lines
+    static int rowWords(int size);
+
+    uint64_t* row(int u) { return bits + static_cast<size_t>(u) * words; }
+    const uint64_t* row(int u) const { return bits + static_cast<size_t>(u) * words; }
+    bool test(int u, int v) const { return (row(u)[v >> 6] >> (v & 63)) & 1; }
+    void set(int u, int v) { row(u)[v >> 6] |= 1ULL << (v & 63); }
+
+    /**
+     * Vertices reachable from `source` by paths whose vertices after the
+     * source all lie in `allowed` (source itself included in `out` only if
+     * some path returns to it). Bit-parallel BFS: each step ORs whole rows.
+     */
+    void reach(int source, const uint64_t* allowed, uint64_t* out, uint64_t* scratch) const;
+
+private:
+    std::pmr::memory_resource* mr;
+    uint64_t* bits = nullptr;
+    size_t bytes = 0;
+};
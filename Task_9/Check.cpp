@@ -0,0 +1,194 @@
+// Cross-checks of the parallel algorithms against plain sequential ones on
+// generated graphs (make check). Threads are forced, so the parallel paths
+// run even on a one-core machine.
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "EdmondsKarp.h"
+#include "GomoryHu.h"
+#include "PushRelabel.h"
+#include "StronglyConnected.h"
+
+constexpr unsigned FORCED_THREADS = 4;
+
+// A directed graph as CSR arrays plus its transpose
+struct TestGraph {
+    int n = 0;
+    std::vector<int64_t> offsets, rOffsets;
+    std::vector<int> targets, rTargets;
+
+    CSRView view() const { return CSRView{n, offsets.data(), targets.data()}; }
+};
+
+static void toCSR(int n, const std::vector<std::pair<int, int>>& arcs,
+                  std::vector<int64_t>& offsets, std::vector<int>& targets) {
+    offsets.assign(n + 1, 0);
+    for (auto& a : arcs) ++offsets[a.first + 1];
+    for (int u = 0; u < n; ++u) offsets[u + 1] += offsets[u];
+    targets.resize(arcs.size());
+    std::vector<int64_t> fill(offsets.begin(), offsets.end() - 1);
+    for (auto& a : arcs) targets[fill[a.first]++] = a.second;
+}
+
+static TestGraph makeGraph(int n, std::vector<std::pair<int, int>> arcs, bool undirected) {
+    if (undirected) {
+        const size_t m = arcs.size();
+        for (size_t i = 0; i < m; ++i) arcs.emplace_back(arcs[i].second, arcs[i].first);
+    }
+    TestGraph g;
+    g.n = n;
+    toCSR(n, arcs, g.offsets, g.targets);
+    for (auto& a : arcs) std::swap(a.first, a.second);
+    toCSR(n, arcs, g.rOffsets, g.rTargets);
+    return g;
+}
+
+// m random arcs without self-loops (parallel arcs allowed)
+static TestGraph randomGraph(std::mt19937& rng, int n, int64_t m, bool undirected) {
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int, int>> arcs;
+    while (static_cast<int64_t>(arcs.size()) < m) {
+        int u = pick(rng), v = pick(rng);
+        if (u != v) arcs.emplace_back(u, v);
+    }
+    return makeGraph(n, std::move(arcs), undirected);
+}
+
+// Source 0 fans out to half the vertices, which feed a random middle that
+// drains into sink n - 1: the first rounds have thousands of active vertices
+static TestGraph wideFlowGraph(std::mt19937& rng, int n) {
+    std::uniform_int_distribution<int> pick(1, n - 2);
+    std::vector<std::pair<int, int>> arcs;
+    for (int v = 1; v <= n / 2; ++v) arcs.emplace_back(0, v);
+    for (int i = 0; i < 3 * n; ++i) {
+        int u = pick(rng), v = pick(rng);
+        if (u != v) arcs.emplace_back(u, v);
+    }
+    for (int i = 0; i < n / 3; ++i) arcs.emplace_back(pick(rng), n - 1);
+    return makeGraph(n, std::move(arcs), false);
+}
+
+// Reference SCCs by recursive-order iterative Kosaraju, labelled like
+// stronglyConnectedComponents(): the smallest vertex of each component
+static std::vector<int> kosaraju(const TestGraph& g) {
+    const int n = g.n;
+    std::vector<char> seen(n, 0);
+    std::vector<int> order, comp(n, -1);
+    std::vector<std::pair<int, int64_t>> st;
+    for (int s = 0; s < n; ++s) {
+        if (seen[s]) continue;
+        seen[s] = 1;
+        st.emplace_back(s, g.offsets[s]);
+        while (!st.empty()) {
+            auto& [u, next] = st.back();
+            if (next < g.offsets[u + 1]) {
+                int v = g.targets[next++];
+                if (!seen[v]) { seen[v] = 1; st.emplace_back(v, g.offsets[v]); }
+            } else {
+                order.push_back(u);
+                st.pop_back();
+            }
+        }
+    }
+    std::vector<int> members;
+    for (int i = n - 1; i >= 0; --i) {
+        int s = order[i];
+        if (comp[s] >= 0) continue;
+        members.assign(1, s);
+        comp[s] = s;
+        for (size_t k = 0; k < members.size(); ++k) {
+            int u = members[k];
+            for (int64_t a = g.rOffsets[u]; a < g.rOffsets[u + 1]; ++a) {
+                int v = g.rTargets[a];
+                if (comp[v] < 0) { comp[v] = s; members.push_back(v); }
+            }
+        }
+        int low = *std::min_element(members.begin(), members.end());
+        for (int v : members) comp[v] = low;
+    }
+    return comp;
+}
+
+static int failures = 0;
+
+static void fail(const std::string& what, unsigned seed) {
+    if (++failures <= 10) std::cerr << "MISMATCH " << what << " (seed " << seed << ")\n";
+}
+
+// Push–relabel with forced threads against Edmonds–Karp
+static void checkFlow(unsigned seed, const TestGraph& g, int s, int t) {
+    int64_t expect = edmondsKarp_unitCap(g.view(), s, t);
+    int64_t got = pushRelabelFlow(g.view(), s, t, FORCED_THREADS);
+    if (got != expect)
+        fail("maxflow " + std::to_string(got) + " != " + std::to_string(expect), seed);
+}
+
+// Forward-backward SCCs with forced threads against Kosaraju
+static void checkSCC(unsigned seed, const TestGraph& g) {
+    std::vector<int> label(g.n);
+    int count = stronglyConnectedComponents(g.n, g.offsets.data(), g.targets.data(),
+                                            g.rOffsets.data(), g.rTargets.data(),
+                                            label.data(), FORCED_THREADS);
+    std::vector<int> expect = kosaraju(g);
+    int expectCount = 0;
+    for (int u = 0; u < g.n; ++u) expectCount += expect[u] == u;
+    if (count != expectCount || label != expect) fail("scc on n=" + std::to_string(g.n), seed);
+}
+
+// Gomory–Hu tree cuts with forced threads against direct flows
+static void checkGomoryHu(std::mt19937& rng, unsigned seed, const TestGraph& g) {
+    GomoryHuTree tree;
+    buildGomoryHu(g.view(), tree, FORCED_THREADS);
+    std::uniform_int_distribution<int> pick(0, g.n - 1);
+    for (int i = 0; i < 8; ++i) {
+        int s = pick(rng), t = pick(rng);
+        if (s == t) continue;
+        if (tree.minCut(s, t) != edmondsKarp_unitCap(g.view(), s, t)) fail("gomory-hu cut", seed);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int rounds = argc > 1 ? std::stoi(argv[1]) : 1500; // small graphs per algorithm
+
+    int flows = 0, sccs = 0, trees = 0;
+    for (int i = 0; i < rounds; ++i) {
+        const unsigned seed = static_cast<unsigned>(i);
+        std::mt19937 rng(seed);
+        const int n = std::uniform_int_distribution<int>(2, 300)(rng);
+        const int64_t m = std::uniform_int_distribution<int64_t>(0, 6 * n)(rng);
+        const bool undirected = i % 2;
+
+        TestGraph g = randomGraph(rng, n, m, undirected);
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        checkFlow(seed, g, pick(rng), pick(rng));
+        ++flows;
+        checkSCC(seed, randomGraph(rng, n, std::uniform_int_distribution<int64_t>(0, 3 * n)(rng), false));
+        ++sccs;
+        if (i % 10 == 0) {
+            checkGomoryHu(rng, seed, randomGraph(rng, std::min(n, 60), 2 * std::min(n, 60), true));
+            ++trees;
+        }
+    }
+
+    // Graphs large enough for the parallel rounds and BFS levels to engage
+    for (int i = 0; i < 10; ++i) {
+        const unsigned seed = 1000000u + static_cast<unsigned>(i);
+        std::mt19937 rng(seed);
+        const int n = 20000 + 2000 * i;
+        TestGraph wide = wideFlowGraph(rng, n);
+        checkFlow(seed, wide, 0, n - 1);
+        checkFlow(seed, randomGraph(rng, n, 4 * static_cast<int64_t>(n), true), 0, n - 1);
+        flows += 2;
+        checkSCC(seed, randomGraph(rng, n, (3 + i % 3) * static_cast<int64_t>(n), false));
+        ++sccs;
+    }
+
+    std::cout << "maxflow: " << flows << " graphs, push-relabel vs Edmonds-Karp\n"
+              << "scc: " << sccs << " graphs, forward-backward vs Kosaraju\n"
+              << "gomory-hu: " << trees << " trees, tree cuts vs Edmonds-Karp\n"
+              << (failures ? std::to_string(failures) + " mismatches\n" : std::string("all match\n"));
+    return failures ? 1 : 0;
+}
@@ -10,9 +10,20 @@
 #include <arpa/inet.h>
 #include <getopt.h>
 #include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <sys/socket.h>
 
 constexpr int  PORT = 12345;
 constexpr char SERVER_IP[] = "127.0.0.1";
+constexpr int  GRAPH_BY_PATH = -1; // V value telling the server to map a .graph file
+constexpr std::int32_t STREAMED_RESULT = -1; // size of a result that arrives in chunks
+constexpr std::size_t MAX_IN_FLIGHT = 64; // requests sent but not fully answered
+
+// Algorithm ids of the response frames, as the server numbers them
+constexpr const char* ALGORITHMS[] = {"mst", "scc", "maxflow", "hamilton"};
 
 // Helper
 static bool writeAll(int fd, const void* buf, std::size_t n)
@@ -52,56 +63,170 @@ buildEdges(int V, int E, unsigned seed)
     return {s.begin(), s.end()};
 }
 
+// Read big-endian fields from a binary result record
+struct RecordReader {
+    const std::string& s;
+    std::size_t at = 0;
+    bool ok() const { return at <= s.size(); }
+    std::uint64_t take(std::size_t n) {
+        std::uint64_t x = 0;
+        for (std::size_t i = 0; i < n && at < s.size(); ++i, ++at) x = (x << 8) | static_cast<std::uint8_t>(s[at]);
+        return x;
+    }
+    std::int32_t i32() { return static_cast<std::int32_t>(take(4)); }
+    std::int64_t i64() { return static_cast<std::int64_t>(take(8)); }
+};
+
+// Print a binary result record (request option encoding=binary) as text
+static std::string describeRecord(const std::string& s)
+{
+    if (s.empty()) return "(empty record)\n";
+    RecordReader in{s};
+    std::ostringstream out;
+    int tag = static_cast<int>(in.take(1));
+    if (tag == 0) {
+        std::int32_t n = in.i32();
+        out << "error: " << s.substr(in.at, n);
+    } else if (tag == 1) {
+        std::int32_t v = in.i32(); int connected = static_cast<int>(in.take(1));
+        out << "mst vertices=" << v << " connected=" << connected << " weight=" << in.i64() << "\n";
+    } else if (tag == 2) {
+        std::int32_t count = in.i32(), k = in.i32();
+        out << "scc count=" << count << " ids=[";
+        for (std::int32_t i = 0; i < k; ++i) out << (i ? " " : "") << in.i32();
+        out << "]\n";
+    } else if (tag == 3) {
+        std::int32_t src = in.i32(), dst = in.i32();
+        out << "flow " << src << "->" << dst << " value=" << in.i64() << "\n";
+    } else if (tag == 4) {
+        int found = static_cast<int>(in.take(1));
+        std::int32_t k = in.i32();
+        out << "cycle found=" << found << " [";
+        for (std::int32_t i = 0; i < k; ++i) out << (i ? " " : "") << in.i32();
+        out << "]\n";
+    } else if (tag == 5) {
+        std::int32_t k = in.i32();
+        for (std::int32_t i = 0; i < k; ++i) {
+            std::int32_t src = in.i32(), dst = in.i32();
+            out << "flow " << src << "->" << dst << " value=" << in.i64() << "\n";
+        }
+    } else if (tag == 6) {
+        auto str = [&] { std::int32_t n = in.i32(); std::string x = s.substr(in.at, n); in.at += n; return x; };
+        std::string algo = str(), variant = str();
+        int requested = static_cast<int>(in.take(1));
+        out << "plan " << algo << " variant=" << (variant.empty() ? "-" : variant) << " requested=" << requested;
+        for (std::int32_t i = 0, k = in.i32(); i < k; ++i) {
+            std::string name = str();
+            out << " " << name << "=" << in.i64();
+        }
+        std::int32_t v = in.i32(); std::int64_t arcs = in.i64(); std::int32_t maxDeg = in.i32();
+        out << " V=" << v << " arcs=" << arcs << " maxdeg=" << maxDeg << " symmetric=" << static_cast<int>(in.take(1)) << "\n";
+    } else {
+        out << "unknown record tag " << tag << "\n";
+    }
+    return out.str();
+}
+
 // Usage function
 static void usage(const char* p) {
-    std::cerr << "Usage: " << p << " -v <vertices> -e <edges> [-s seed]\n";
+    std::cerr << "Usage: " << p << " -v <vertices> -e <edges> [-s seed]\n"
+              << "       " << p << " -f <.graph file, relative to the server's graph directory>\n"
+              << "Requests: <algo> [key=value ...] [stream], e.g. \"scc format=count\"\n"
+              << "          encoding=binary asks for compact result records\n"
+              << "          variant=<name> picks an implementation, explain shows the choice\n"
+              << "Requests are pipelined: answers print as \"#<request> <algo> → ...\" as they complete\n";
 }
 
-// Sends a request to the server for a given algorithm and graph, and prints the result
-static void doRequest(int sock,
-                      const std::string& algo,
-                      int V, int E,
-                      const std::vector<std::pair<int,int>>& edges)
+// Requests in flight: the request line and how many responses are still due
+struct Pending {
+    std::string request;
+    int due;
+};
+
+static std::mutex ioLock; // guards `inFlight`, `lost` and std::cout
+static std::condition_variable answered;
+static std::map<std::int32_t, Pending> inFlight;
+static bool lost = false;
+
+// Sends a request for a given algorithm and graph, tagged with `id`; the
+// responses are printed by receiveResponses() whenever they arrive.
+// With a non-empty `graphFile` the server maps that .graph file instead of receiving edges.
+static void sendRequest(int sock,
+                        std::int32_t id,
+                        const std::string& algo,
+                        int V, int E,
+                        const std::vector<std::pair<int,int>>& edges,
+                        const std::string& graphFile)
 {
-    // Send number of vertices and edges (as network-order integers)
-    std::int32_t v_net  = htonl(V);
-    std::int32_t e_net  = htonl(E);
-    if (!writeAll(sock, &v_net, 4) ||
-        !writeAll(sock, &e_net, 4)) { throw std::runtime_error("send"); }
-
-    // Send edge list
-    for (auto [u,v] : edges) {
-        std::int32_t u_net = htonl(u), v_net = htonl(v);
-        if (!writeAll(sock, &u_net, 4) ||
-            !writeAll(sock, &v_net, 4)) throw std::runtime_error("send");
+    // Request id first; the server echoes it in each response
+    std::int32_t id_net = htonl(id);
+    if (!writeAll(sock, &id_net, 4)) throw std::runtime_error("send");
+
+    if (!graphFile.empty())
+    {
+        // Graph by reference: V = -1, then the path length and the path itself
+        std::int32_t v_net = htonl(GRAPH_BY_PATH);
+        std::int32_t l_net = htonl(static_cast<std::int32_t>(graphFile.size()));
+        if (!writeAll(sock, &v_net, 4) ||
+            !writeAll(sock, &l_net, 4) ||
+            !writeAll(sock, graphFile.data(), graphFile.size())) throw std::runtime_error("send");
+    }
+    else
+    {
+        // Send number of vertices and edges (as network-order integers)
+        std::int32_t v_net  = htonl(V);
+        std::int32_t e_net  = htonl(E);
+        if (!writeAll(sock, &v_net, 4) ||
+            !writeAll(sock, &e_net, 4)) { throw std::runtime_error("send"); }
+
+        // Send edge list
+        for (auto [u,v] : edges) {
+            std::int32_t u_net = htonl(u), v_net = htonl(v);
+            if (!writeAll(sock, &u_net, 4) ||
+                !writeAll(sock, &v_net, 4)) throw std::runtime_error("send");
+        }
     }
 
     // Send algorithm name as a string: first its length, then the raw characters
     std::int32_t len = htonl(static_cast<std::int32_t>(algo.size()));
     if (!writeAll(sock, &len, 4) ||
         !writeAll(sock, algo.data(), algo.size())) throw std::runtime_error("send");
+}
 
-    
-    // Read a response from the server: [size][data] format
-    auto readOne = [&]{
-        std::int32_t n_net; if (!readAll(sock, &n_net, 4)) return std::string{};
-        int n = ntohl(n_net);
-        std::string s(n, '\0');
-        if (!readAll(sock, s.data(), n)) return std::string{};
-        return s;
-    };
-
-    // If running all algorithms, expect 4 results (one per algorithm)
-    if (algo == "all") 
-    {
-        for (std::string name : {"mst","scc","maxflow","hamilton"})
-        {
-            std::cout << name << " → " << readOne();
+// Render a result body the way its request asked for it
+static std::string describe(const std::string& request, const std::string& s)
+{
+    if (request.find("encoding=binary") != std::string::npos) return describeRecord(s);
+    return s;
+}
+
+// Receiver thread: responses arrive in completion order as
+// [request id][algorithm id] then [size][data], or a streamed result:
+// [-1] then [size][data] chunks up to a zero size
+static void receiveResponses(int sock)
+{
+    for (;;) {
+        std::int32_t head[3];
+        bool ok = readAll(sock, head, sizeof(head));
+        std::int32_t id = ntohl(head[0]), algoId = ntohl(head[1]), n = ntohl(head[2]);
+        std::string s;
+        for (bool streamed = (n == STREAMED_RESULT); ok; ) {
+            std::int32_t n_net;
+            if (streamed && (!(ok = readAll(sock, &n_net, 4)) || (n = ntohl(n_net)) == 0)) break;
+            size_t at = s.size();
+            s.resize(at + n);
+            ok = readAll(sock, &s[at], n);
+            if (!streamed) break;
         }
-    } 
-    else // Otherwise, just read one result
-    {
-        std::cout << readOne();
+
+        std::lock_guard<std::mutex> lk(ioLock);
+        if (!ok) { lost = true; answered.notify_all(); return; }
+        auto it = inFlight.find(id);
+        if (it == inFlight.end()) { std::cout << "#" << id << " unexpected response\n"; continue; }
+        const char* name = algoId >= 0 && algoId < 4 ? ALGORITHMS[algoId] : "?";
+        std::cout << "#" << id << " " << name << " → " << describe(it->second.request, s) << std::flush;
+        if (--it->second.due == 0) inFlight.erase(it);
+        answered.notify_all();
     }
 }
 
@@ -109,14 +234,16 @@ int main(int argc, char* argv[])
 {
     // Parse options: number of vertices, edges, and optional RNG seed
     int V=-1, E=-1; unsigned seed = 42;
+    std::string graphFile;
     int opt;
-    while ((opt = getopt(argc, argv, "v:e:s:")) != -1) {
+    while ((opt = getopt(argc, argv, "v:e:s:f:")) != -1) {
         if (opt=='v') V = std::stoi(optarg);
         else if (opt=='e') E = std::stoi(optarg);
         else if (opt=='s') seed = std::stoul(optarg);
+        else if (opt=='f') graphFile = optarg;
         else { usage(argv[0]); return 1; }
     }
-    if (V<=0 || E<0) { usage(argv[0]); return 1; }
+    if (graphFile.empty() && (V<=0 || E<0)) { usage(argv[0]); return 1; }
 
     // Create and connect TCP socket to the server
     int sock = socket(AF_INET, SOCK_STREAM, 0);
@@ -126,24 +253,43 @@ int main(int argc, char* argv[])
         perror("connect"); return 1;
     }
     std::cout << "Connected to " << SERVER_IP << ":" << PORT << '\n';
+    std::thread receiver(receiveResponses, sock);
 
-    // Loop: prompt for algorithm name and send request
+    // Loop: prompt for algorithm name and send request without waiting for the answer
     std::string algo;
-    while (true) {
-        std::cout << "algo> ";
+    for (std::int32_t id = 1; ; ++id) {
+        { std::lock_guard<std::mutex> lk(ioLock); std::cout << "algo> " << std::flush; }
         if (!std::getline(std::cin, algo) || algo=="quit") break;
         if (algo.empty()) continue;
 
-        auto edges = buildEdges(V, E, seed); // Generate edges
+        // Generate edges (unless the graph lives in a file on the server)
+        std::vector<std::pair<int,int>> edges;
+        if (graphFile.empty()) edges = buildEdges(V, E, seed);
+        {
+            // Keep at most MAX_IN_FLIGHT requests outstanding
+            std::unique_lock<std::mutex> lk(ioLock);
+            answered.wait(lk, [&]{ return inFlight.size() < MAX_IN_FLIGHT || lost; });
+            if (lost) break;
+            // "all" is answered once per algorithm
+            inFlight[id] = {algo, algo.substr(0, algo.find(' ')) == "all" ? 4 : 1};
+        }
         // Send request and handle errors
         try 
         { 
-            doRequest(sock, algo, V, E, edges); 
+            sendRequest(sock, id, algo, V, E, edges, graphFile); 
         }
         catch (...) { 
-            std::cerr << "connection lost\n"; break; 
+            break; 
         }
     }
 
+    // Wait for the answers still on their way, then hang up
+    {
+        std::unique_lock<std::mutex> lk(ioLock);
+        answered.wait(lk, [&]{ return inFlight.empty() || lost; });
+        if (lost && !inFlight.empty()) std::cerr << "connection lost\n";
+    }
+    shutdown(sock, SHUT_RDWR);
+    receiver.join();
     close(sock);
 }
@@ -0,0 +1,123 @@
+#include "ClientWriter.h"
+#include <cerrno>
+#include <cstdint>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+ClientWriter::ClientWriter() : wakeFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {}
+
+ClientWriter::~ClientWriter() {
+    if (wakeFd >= 0) close(wakeFd);
+}
+
+// The client is gone or not reading: the handler sees the shutdown and stops too
+void ClientWriter::fail(Outbox& box) {
+    box.conn->closed = true;
+    shutdown(box.conn->fd, SHUT_RDWR);
+}
+
+void ClientWriter::queue(const std::shared_ptr<Connection>& conn, Segment s, size_t bytes) {
+    if (bytes == 0 || conn->closed) return;
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lk(m);
+        Outbox& box = boxes[conn->fd];
+        if (!box.conn) box.conn = conn;
+        wake = box.segments.empty() && !box.blocked;
+        box.segments.push_back(std::move(s));
+        box.bytes += bytes;
+        if (box.bytes > MAX_OUTBOX_BYTES) {
+            fail(box);
+            boxes.erase(conn->fd);
+            return;
+        }
+    }
+    if (wake) {
+        uint64_t one = 1;
+        (void)!write(wakeFd, &one, sizeof(one));
+    }
+}
+
+void ClientWriter::append(const std::shared_ptr<Connection>& conn, std::string bytes) {
+    const size_t n = bytes.size();
+    Segment s;
+    s.bytes = std::move(bytes);
+    queue(conn, std::move(s), n);
+}
+
+void ClientWriter::appendStored(const std::shared_ptr<Connection>& conn, const ResultStore& store,
+                                const ResultStore::Entry& e) {
+    Segment s;
+    s.store = &store;
+    s.entry = e;
+    queue(conn, std::move(s), e.length);
+}
+
+bool ClientWriter::drain(Outbox& box) {
+    const int fd = box.conn->fd;
+    while (!box.segments.empty()) {
+        Segment& s = box.segments.front();
+        if (s.store) {
+            const uint32_t before = s.entry.length;
+            if (!s.store->sendTo(fd, s.entry)) return false;
+            box.bytes -= before - s.entry.length;
+            if (s.entry.length) { box.blocked = true; return true; }
+        } else {
+            while (s.sent < s.bytes.size()) {
+                ssize_t w = send(fd, s.bytes.data() + s.sent, s.bytes.size() - s.sent, MSG_NOSIGNAL);
+                if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { box.blocked = true; return true; }
+                if (w <= 0) return false;
+                s.sent += static_cast<size_t>(w);
+                box.bytes -= static_cast<size_t>(w);
+            }
+        }
+        box.segments.pop_front();
+    }
+    box.blocked = false;
+    return true;
+}
+
+void ClientWriter::run() {
+    std::vector<pollfd> fds;
+    for (;;) {
+        // Wait for new bytes or for a full socket to take more
+        fds.assign(1, pollfd{wakeFd, POLLIN, 0});
+        {
+            std::lock_guard<std::mutex> lk(m);
+            for (auto& [fd, box] : boxes)
+                if (box.blocked) fds.push_back(pollfd{fd, POLLOUT, 0});
+        }
+        const bool last = stopping;
+        if (!last && poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR) return;
+        uint64_t count;
+        (void)!read(wakeFd, &count, sizeof(count));
+
+        std::lock_guard<std::mutex> lk(m);
+        for (size_t i = 1; i < fds.size(); ++i) {
+            auto it = boxes.find(fds[i].fd);
+            if (it != boxes.end() && fds[i].revents) it->second.blocked = false;
+        }
+        for (auto it = boxes.begin(); it != boxes.end();) {
+            Outbox& box = it->second;
+            if (box.blocked) { ++it; continue; }
+            if (!drain(box)) {
+                fail(box);
+                it = boxes.erase(it);
+            } else if (box.segments.empty()) {
+                it = boxes.erase(it); // may close the socket, if nothing else holds it
+            } else {
+                ++it;
+            }
+        }
+        if (last) return;
+    }
+}
+
+void ClientWriter::stop() {
+    stopping = true;
+    uint64_t one = 1;
+    (void)!write(wakeFd, &one, sizeof(one));
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "Connection.h"
+#include "ResultStore.h"
+
+// Unsent bytes a client may let pile up before it is disconnected
+constexpr size_t MAX_OUTBOX_BYTES = size_t(1) << 28;
+
+/**
+ * Outbound buffers of the client sockets, drained by one writer thread.
+ *
+ * The response stage appends a client's frames to its outbox and goes on
+ * with the next client; it never blocks on a socket. The writer sends
+ * whatever each socket takes without blocking and poll()s the full ones
+ * until they drain. A client that stops reading only backs up its own
+ * outbox, and is shut down once more than MAX_OUTBOX_BYTES wait in it.
+ * Cached payloads are queued as ranges of the result store and leave
+ * with sendfile(). An outbox holds its Connection until it is empty, so
+ * the socket is not closed before its last byte is sent; a failed socket
+ * marks the connection closed and drops the rest.
+ *
+ * Client sockets must be non-blocking.
+ */
+class ClientWriter {
+public:
+    ClientWriter();
+    ~ClientWriter();
+
+    ClientWriter(const ClientWriter&) = delete;
+    ClientWriter& operator=(const ClientWriter&) = delete;
+
+    // Queue bytes, or a stored payload, behind what the connection already has queued
+    void append(const std::shared_ptr<Connection>& conn, std::string bytes);
+    void appendStored(const std::shared_ptr<Connection>& conn, const ResultStore& store,
+                      const ResultStore::Entry& e);
+
+    // Writer thread: runs until stop(), then sends what the sockets still take
+    void run();
+    void stop();
+
+private:
+    struct Segment {
+        std::string bytes;                 // sent from `sent` on...
+        size_t sent = 0;
+        const ResultStore* store = nullptr; // ...or, if set, this stored payload
+        ResultStore::Entry entry;
+    };
+    struct Outbox {
+        std::shared_ptr<Connection> conn;
+        std::deque<Segment> segments;
+        size_t bytes = 0;     // unsent bytes
+        bool blocked = false; // socket full: wait for POLLOUT
+    };
+
+    std::mutex m;
+    std::map<int, Outbox> boxes; // by socket; only clients with unsent bytes
+    int wakeFd;                  // eventfd: new bytes, or stop()
+    std::atomic<bool> stopping{false};
+
+    void queue(const std::shared_ptr<Connection>& conn, Segment s, size_t bytes);
+    bool drain(Outbox& box); // caller holds the lock; false on a failed socket
+    static void fail(Outbox& box);
+};
@@ -0,0 +1,25 @@
+#pragma once
+#include <atomic>
+#include <unistd.h>
+
+/**
+ * One client connection, shared by everything still working for it: the
+ * handler reading its requests, its queued tasks and responses, and its
+ * outbox in the ClientWriter.
+ *
+ * The socket is closed when the last of them lets go, so it stays open
+ * until the last response has been sent, and its descriptor number cannot
+ * be reused by a new connection while anything might still write to it.
+ * Responses travel with this object rather than with the descriptor
+ * number, so they can only reach the connection that asked.
+ */
+struct Connection {
+    const int fd;
+    std::atomic<bool> closed{false}; // writes failed: drop its remaining work
+
+    explicit Connection(int f) : fd(f) {}
+    ~Connection() { ::close(fd); }
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+};
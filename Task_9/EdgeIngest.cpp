@@ -0,0 +1,46 @@
+#include "EdgeIngest.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+EdgeIngest::EdgeIngest(int vertices, std::pmr::memory_resource* mr)
+    : n(std::max(vertices, 0)), parent(n, mr), deg(n, 0, mr) {
+    std::iota(parent.begin(), parent.end(), 0);
+}
+
+int EdgeIngest::find(int x) {
+    while (parent[x] != x) x = parent[x] = parent[parent[x]]; // path halving
+    return x;
+}
+
+void EdgeIngest::add(const Edge* edges, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        int u = edges[i].u, v = edges[i].v;
+        if (u < 0 || u >= n || v < 0 || v >= n || u == v) { ++skipped; continue; }
+        ++deg[u];
+        ++deg[v];
+        int a = find(u), b = find(v);
+        if (a != b) parent[std::max(a, b)] = std::min(a, b);
+    }
+}
+
+Components EdgeIngest::components() {
+    Components cc(parent.get_allocator().resource());
+    cc.id.assign(n, -1);
+    for (int u = 0; u < n; ++u) {
+        int r = find(u);
+        if (r == u) cc.id[u] = cc.count++;
+        cc.id[u] = cc.id[r];
+    }
+    return cc;
+}
+
+int EdgeIngest::componentCount() {
+    int count = 0;
+    for (int u = 0; u < n; ++u) count += find(u) == u;
+    return count;
+}
+
+std::pmr::vector<int> EdgeIngest::degrees() {
+    return std::move(deg);
+}
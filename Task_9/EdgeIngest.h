@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+#include "Graph.h"
+#include "GraphContext.h"
+
+/**
+ * Connectivity and degree summary of an undirected edge list, folded in
+ * chunk by chunk while the list is still arriving from the network.
+ *
+ * Each edge costs a union-find step and two degree increments, cheap enough
+ * to hide behind the next read. When the last chunk lands the components and
+ * degrees are already known, so they are handed to the GraphContext instead
+ * of being recomputed, and MST existence (or Euler parity) needs no further
+ * pass over the graph.
+ *
+ * Roots are always the smallest vertex of their set, so the component
+ * numbering matches GraphContext::components().
+ */
+class EdgeIngest {
+public:
+    EdgeIngest(int n, std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+    // Fold a chunk of undirected edges (host byte order).
+    // Out-of-range endpoints and self-loops are skipped here; Graph::addEdges rejects them.
+    void add(const Edge* edges, size_t count);
+
+    // No edge was skipped: the list is one Graph::addEdges accepts
+    bool valid() const { return skipped == 0; }
+
+    // Number of components, without numbering them
+    int componentCount();
+
+    // Components numbered in vertex order, and the vertex degrees
+    Components components();
+    std::pmr::vector<int> degrees();
+
+private:
+    int n;
+    size_t skipped = 0;
+    std::pmr::vector<int> parent;
+    std::pmr::vector<int> deg;
+
+    int find(int x);
+};
@@ -0,0 +1,89 @@
+#include "EdmondsKarp.h"
+#include "Workspace.h"
+#include "HybridBFS.h"
+
+#include <algorithm>
+#include <limits>
+
+int edmondsKarp_unitCap(const CSRView& G, int s, int t, char* sourceSide) {
+    const int n = G.n;
+    if (n == 0 || s < 0 || t < 0 || s >= n || t >= n) return 0;
+    if (s == t) return 0;
+
+    // Build the residual network from the shared CSR: every arc u->v becomes a
+    // forward arc with capacity 1 plus a paired reverse arc with capacity 0
+    // (parallel edges stay separate arcs, so their capacities add up).
+    Workspace::Scope scope;
+    int64_t* start = scope.take<int64_t>(n + 1, 0);
+    for (int u = 0; u < n; ++u) {
+        start[u + 1] += G.degree(u);
+        for (const int* p = G.begin(u); p != G.end(u); ++p) ++start[*p + 1];
+    }
+    for (int u = 0; u < n; ++u) start[u + 1] += start[u];
+
+    const size_t m = static_cast<size_t>(start[n]);
+    int* head = scope.take<int>(m);
+    int* cap = scope.take<int>(m);
+    int64_t* pair = scope.take<int64_t>(m);
+    int64_t* fill = scope.take<int64_t>(n);
+    std::copy(start, start + n, fill);
+    for (int u = 0; u < n; ++u) {
+        for (const int* p = G.begin(u); p != G.end(u); ++p) {
+            int64_t a = fill[u]++, b = fill[*p]++;
+            head[a] = *p; cap[a] = 1; pair[a] = b;
+            head[b] = u;  cap[b] = 0; pair[b] = a;
+        }
+    }
+
+    // Residual network as seen by HybridBFS. The arcs entering v are the
+    // partners of v's own arcs, so bottom-up steps need no separate transpose.
+    struct Residual {
+        int n;
+        const int64_t* start;
+        const int* head;
+        const int* cap;
+        const int64_t* pair;
+        int outDegree(int u) const { return static_cast<int>(start[u + 1] - start[u]); }
+        int outTarget(int u, int i) const { return head[start[u] + i]; }
+        int64_t outArc(int u, int i) const { return start[u] + i; }
+        int inDegree(int v) const { return outDegree(v); }
+        int inSource(int v, int i) const { return head[start[v] + i]; }
+        int64_t inArc(int v, int i) const { return pair[start[v] + i]; }
+        bool usable(int64_t a) const { return cap[a] > 0; }
+    } residual{n, start, head, cap, pair};
+
+    int maxflow = 0;
+    int64_t* parentArc = scope.take<int64_t>(n); // arc used to reach each vertex
+    HybridBFS search;
+
+    // Shortest augmenting path; returns its bottleneck, 0 if the sink is unreachable
+    auto bfs = [&](int source, int sink) -> int {
+        std::fill(parentArc, parentArc + n, -1);
+        search.run(residual, source, sink, parentArc, static_cast<int64_t>(m));
+        if (parentArc[sink] == -1) return 0;
+        int bottleneck = std::numeric_limits<int>::max();
+        for (int v = sink; v != source; v = head[pair[parentArc[v]]])
+            bottleneck = std::min(bottleneck, cap[parentArc[v]]);
+        return bottleneck;
+    };
+
+    while (true) {
+        int aug = bfs(s, t);
+        if (aug == 0) break; // no more augmenting paths
+
+        maxflow += aug;
+        // backtrack and update residual capacities
+        int v = t;
+        while (v != s) {
+            int64_t a = parentArc[v];
+            cap[a] -= aug;
+            cap[pair[a]] += aug;
+            v = head[pair[a]];
+        }
+    }
+
+    // The last search stopped short of the sink: what it reached is the source side
+    if (sourceSide)
+        for (int v = 0; v < n; ++v) sourceSide[v] = parentArc[v] != -1;
+    return maxflow;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "GraphContext.h"
+
+/**
+ * Max flow by Edmonds–Karp with unit capacities.
+ *
+ *  - The CSR's arcs are directed edges of capacity 1 (parallel arcs add up;
+ *    an undirected graph has both directions, so capacity both ways).
+ *  - Augmenting paths are found by direction-optimizing BFS (HybridBFS.h)
+ *    over the residual network.
+ *
+ * When `sourceSide` is given (n bytes), on return sourceSide[v] is 1 for the
+ * vertices still reachable from s in the residual network, i.e. the source
+ * side of a minimum s-t cut. It is left untouched if s == t or either is out
+ * of range. Temporaries come from the calling thread's Workspace, so several
+ * threads may run flows on the same CSR at once.
+ */
+int edmondsKarp_unitCap(const CSRView& G, int s, int t, char* sourceSide = nullptr);
@@ -0,0 +1,62 @@
+#include "GomoryHu.h"
+#include "EdmondsKarp.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+int64_t GomoryHuTree::minCut(int s, int t) const {
+    if (s == t) return 0;
+    int64_t cut = INT64_MAX;
+    // Climb from the deeper end until both meet at their common ancestor
+    while (s != t) {
+        if (depth[s] < depth[t]) std::swap(s, t);
+        cut = std::min(cut, weight[s]);
+        s = parent[s];
+    }
+    return cut;
+}
+
+void buildGomoryHu(const CSRView& G, GomoryHuTree& out, unsigned threads) {
+    const int n = G.n;
+    out.parent.assign(n, 0);
+    out.weight.assign(n, 0);
+    out.depth.assign(n, 0);
+    if (n <= 1) return;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const int window = static_cast<int>(std::min(threads, GOMORY_HU_MAX_WINDOW));
+
+    std::vector<int> parent(n, 0);
+    std::vector<int> snapshot(window);            // parent each window flow was run against
+    std::vector<int64_t> flow(window);
+    std::vector<char> side(static_cast<size_t>(window) * n); // source side of each cut
+
+    for (int i = 1; i < n;) {
+        const int w = std::min(window, n - i);
+        for (int k = 0; k < w; ++k) snapshot[k] = parent[i + k];
+
+        // Speculative flows for i .. i+w-1, one thread each
+        auto cut = [&](unsigned k) {
+            flow[k] = edmondsKarp_unitCap(G, i + k, snapshot[k], &side[static_cast<size_t>(k) * n]);
+        };
+        ThreadPool::shared().run(w, cut);
+
+        // Apply in order until a flow turns out to be stale
+        int k = 0;
+        for (; k < w && parent[i + k] == snapshot[k]; ++k) {
+            const int s = i + k, t = parent[s];
+            const char* x = &side[static_cast<size_t>(k) * n];
+            out.weight[s] = flow[k];
+            for (int j = s + 1; j < n; ++j)
+                if (parent[j] == t && x[j]) parent[j] = s;
+        }
+        i += k;
+    }
+
+    // Parents precede their children, so depths fill in one pass
+    for (int u = 1; u < n; ++u) {
+        out.parent[u] = parent[u];
+        out.depth[u] = out.depth[parent[u]] + 1;
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "GraphContext.h"
+
+// Most tree flows computed concurrently in one window
+constexpr unsigned GOMORY_HU_MAX_WINDOW = 64;
+
+/**
+ * Build the Gomory–Hu tree of a symmetric (undirected) unit-capacity graph
+ * with Gusfield's algorithm: n - 1 max-flow computations on the original
+ * graph, no contractions.
+ *
+ * Step i computes a minimum cut between i and its current parent p[i]; the
+ * later vertices j > i that share that parent and fall on i's side are
+ * re-hung under i. A step only depends on p[i], so the flows for a window of
+ * upcoming vertices are computed in parallel against a snapshot of p and
+ * then applied in order; a vertex whose parent changed inside the window is
+ * redone in the next one.
+ *
+ * `threads = 0` uses hardware_concurrency().
+ */
+void buildGomoryHu(const CSRView& G, GomoryHuTree& out, unsigned threads = 0);
@@ -1,11 +1,19 @@
 #include "Graph.h"
+#include "ThreadPool.h"
+#include <algorithm>
 #include <stdexcept>
+#include <vector>
 
 // Constructor
-Graph::Graph(int n) : numVertices(n), adjacencyList(n) {
+Graph::Graph(int n, std::pmr::memory_resource* mr) : numVertices(n), symmetric(true), adjacencyList(mr) {
     if (n < 0) {
         throw std::invalid_argument("Number of vertices must be non-negative.");
     }
+    adjacencyList.resize(n); // inner lists inherit the resource
+}
+
+std::pmr::memory_resource* Graph::resource() const {
+    return adjacencyList.get_allocator().resource();
 }
 
 // Vertex bounds checker
@@ -20,6 +28,12 @@ int Graph::V() const {
     return numVertices;
 }
 
+// Run job(0) .. job(chunks - 1) on the shared pool
+template<typename Job>
+static void runChunks(unsigned chunks, Job& job) {
+    ThreadPool::shared().run(chunks, [&job](unsigned t) { job(t); });
+}
+
 // Add an undirected edge
 void Graph::addEdge(int u, int v) {
     validateVertex(u);
@@ -36,14 +50,86 @@ void Graph::addDirectedEdge(int u, int v) {
     validateVertex(u);
     validateVertex(v);
     adjacencyList[u].push_back(v);
+    symmetric = false;
+}
+
+void Graph::addEdges(const Edge* edges, size_t count, unsigned threads) {
+    insertEdges(edges, count, false, threads);
+}
+
+void Graph::addDirectedEdges(const Edge* edges, size_t count, unsigned threads) {
+    insertEdges(edges, count, true, threads);
+}
+
+// Two streaming passes over the edge list: validate + count, then scatter.
+// With several threads each one owns a contiguous chunk of the list; a
+// per-chunk prefix sum of the degrees tells it where its arcs go in every
+// list, so the lists come out in edge-list order. Each chunk keeps a cursor
+// per vertex, so there are at most E / V chunks: the cursors stay O(V + E).
+void Graph::insertEdges(const Edge* edges, size_t count, bool directed, unsigned threads) {
+    const int n = numVertices;
+    const size_t perVertex = n > 0 ? count / static_cast<size_t>(n) : 0;
+    const unsigned chunks = threads <= 1 || n < 2 || perVertex < 2
+        ? 1 : static_cast<unsigned>(std::min<size_t>(threads, perVertex));
+    auto chunkBegin = [&](unsigned t) { return count * t / chunks; };
+
+    // Pass 1: validate everything before touching the graph, and count each
+    // chunk's arcs per vertex (slot[t * n + u])
+    std::vector<int64_t> slot(static_cast<size_t>(chunks) * n, 0);
+    std::vector<int> bad(chunks, 0); // 1 out of range, 2 self-loop
+    auto count1 = [&](unsigned t) {
+        int64_t* c = slot.data() + static_cast<size_t>(t) * n;
+        for (size_t i = chunkBegin(t); i < chunkBegin(t + 1); ++i) {
+            const Edge& e = edges[i];
+            if (e.u < 0 || e.u >= n || e.v < 0 || e.v >= n) { bad[t] = 1; return; }
+            ++c[e.u];
+            if (directed) continue;
+            if (e.u == e.v) { bad[t] = 2; return; }
+            ++c[e.v];
+        }
+    };
+    runChunks(chunks, count1);
+    for (int b : bad) {
+        if (b == 1) throw std::out_of_range("Vertex index out of bounds.");
+        if (b == 2) throw std::invalid_argument("Self-loops are not supported in this version.");
+    }
+    if (directed && count) symmetric = false;
+
+    // Turn the counts into each chunk's first slot in every list and size
+    // the lists; vertex ranges are independent
+    auto place = [&](unsigned t) {
+        const int lo = static_cast<int>(static_cast<long long>(n) * t / chunks);
+        const int hi = static_cast<int>(static_cast<long long>(n) * (t + 1) / chunks);
+        for (int u = lo; u < hi; ++u) {
+            int64_t at = static_cast<int64_t>(adjacencyList[u].size());
+            for (unsigned c = 0; c < chunks; ++c) {
+                int64_t k = slot[static_cast<size_t>(c) * n + u];
+                slot[static_cast<size_t>(c) * n + u] = at;
+                at += k;
+            }
+            if (at != static_cast<int64_t>(adjacencyList[u].size())) adjacencyList[u].resize(at);
+        }
+    };
+    runChunks(chunks, place);
+
+    // Pass 2: scatter; every chunk writes its own slots
+    auto scatter = [&](unsigned t) {
+        int64_t* at = slot.data() + static_cast<size_t>(t) * n;
+        for (size_t i = chunkBegin(t); i < chunkBegin(t + 1); ++i) {
+            const Edge& e = edges[i];
+            adjacencyList[e.u][at[e.u]++] = e.v;
+            if (!directed) adjacencyList[e.v][at[e.v]++] = e.u;
+        }
+    };
+    runChunks(chunks, scatter);
 }
 
 // Return raw pointer for compatibility with `vector<int> adj[]`
-std::vector<int>* Graph::raw() {
+Graph::AdjList* Graph::raw() {
     return adjacencyList.data();
 }
 
-const std::vector<int>* Graph::raw() const {
+const Graph::AdjList* Graph::raw() const {
     return adjacencyList.data();
 }
 
@@ -53,7 +139,11 @@ int Graph::degree(int v) const {
     return static_cast<int>(adjacencyList[v].size());
 }
 
-const std::vector<int>& Graph::getAdj(int u) const {
+bool Graph::undirected() const {
+    return symmetric;
+}
+
+const Graph::AdjList& Graph::getAdj(int u) const {
     validateVertex(u);
     return adjacencyList[u];
 }
@@ -63,4 +153,5 @@ void Graph::clear() {
     for (auto& vec : adjacencyList) {
         vec.clear();
     }
+    symmetric = true;
 }
@@ -1,20 +1,40 @@
 #pragma once
+#include <cstddef>
 #include <vector>
+#include <memory_resource>
+
+// One edge as it appears in an uploaded edge list
+struct Edge {
+    int u;
+    int v;
+};
 
 /**
  * Simple undirected graph class.
  * Stores adjacency lists and allows adding edges.
+ *
+ * All lists are allocated from one memory resource, so a request-scoped
+ * arena can own the whole graph and free it in one step.
  */
 class Graph {
+public:
+    // Neighbours of one vertex
+    using AdjList = std::pmr::vector<int>;
+
 private:
     int numVertices;
-    std::vector<std::vector<int>> adjacencyList;
+    bool symmetric; // every arc u->v has a matching v->u
+    std::pmr::vector<AdjList> adjacencyList;
 
     void validateVertex(int v) const;
+    void insertEdges(const Edge* edges, size_t count, bool directed, unsigned threads);
 
 public:
     // Constructor
-    Graph(int n);
+    Graph(int n, std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+    // Memory resource backing the adjacency lists
+    std::pmr::memory_resource* resource() const;
 
     // Return number of vertices
     int V() const;
@@ -25,16 +45,25 @@ public:
     // Add directed edge u -> v
     void addDirectedEdge(int u, int v);
 
+    // Bulk insert: validate the whole list once, count degrees, size each
+    // list exactly, then scatter. With threads > 1 the list is split into
+    // one chunk per thread. Neighbour order matches repeated addEdge calls.
+    void addEdges(const Edge* edges, size_t count, unsigned threads = 1);
+    void addDirectedEdges(const Edge* edges, size_t count, unsigned threads = 1);
+
     // Return raw pointer to adjacency list array
-    std::vector<int>* raw();
-    const std::vector<int>* raw() const;
+    AdjList* raw();
+    const AdjList* raw() const;
 
     // Get all neighbors
-    const std::vector<int>& getAdj(int u) const;
+    const AdjList& getAdj(int u) const;
 
     // Get degree of a vertex
     int degree(int v) const;
 
+    // True until a directed edge is added
+    bool undirected() const;
+
     // Clear all edges
     void clear();
 };
@@ -1,13 +1,22 @@
 #pragma once
+#include <map>
 #include <string>
 #include "Graph.h"
+#include "GraphContext.h"
+#include "AlgorithmResult.h"
 
 /**
  * Base interface for any graph algorithm.
  * 
  * Every algorithm needs to say what it's called (like "mst", "scc", or "maxflow")
- * and be able to run on a given Graph object, returning the result as a string
- * that can be shown directly to the user.
+ * and be able to run on a given Graph object. It computes a typed result
+ * (AlgorithmResult.h); run() encodes that as the text shown to the user.
+ *
+ * Algorithms implement compute(GraphContext&, ...) so that several algorithms
+ * running on the same graph share the derived data (CSR, components, SCCs, ...).
+ *
+ * A request may carry options after the name ("scc format=count"); they
+ * reach the algorithm through compute().
  */
 class GraphAlgorithm {
 public:
@@ -16,6 +25,22 @@ public:
     // Return a short identifier for the algorithm (e.g. "mst", "scc").
     virtual std::string name() const = 0;
 
+    // Request options, e.g. {"format": "ids"}; a bare word maps to "1"
+    using Options = std::map<std::string, std::string>;
+
+    // Run the algorithm on a shared analysis context. The result may point
+    // into the context (e.g. the SCC decomposition), so encode it while the
+    // context is alive.
+    virtual AlgorithmResult compute(GraphContext& ctx, const Options& opts) = 0;
+
+    // Run the algorithm on a shared analysis context and return a result string.
+    std::string run(GraphContext& ctx) {
+        return encodeResult(compute(ctx, Options{}), Encoding::Text);
+    }
+
     // Run the algorithm on the given graph and return a result string.
-    virtual std::string run(const Graph& g) = 0;
+    std::string run(const Graph& g) {
+        GraphContext ctx(g);
+        return run(ctx);
+    }
 };
@@ -0,0 +1,249 @@
+#include "GraphContext.h"
+#include "Workspace.h"
+#include "ConnectedComponents.h"
+#include "StronglyConnected.h"
+#include "GomoryHu.h"
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+GraphContext::GraphContext(std::shared_ptr<const Graph> graph,
+                           std::shared_ptr<std::pmr::memory_resource> mem)
+    : arena(std::move(mem)), g(std::move(graph)), n(g->V()),
+      deg(g->resource()),
+      csrOffsets(g->resource()), transposeOffsets(g->resource()),
+      csrTargets(g->resource()), transposeTargets(g->resource()),
+      cc(g->resource()), sccs(g->resource()), adjMatrix(g->resource()),
+      ght(g->resource()) {}
+
+// Aliasing constructor with an empty owner: points at `graph` without owning it
+GraphContext::GraphContext(const Graph& graph)
+    : GraphContext(std::shared_ptr<const Graph>(std::shared_ptr<const Graph>(), &graph)) {}
+
+GraphContext::GraphContext(std::shared_ptr<const MappedGraph> mapped)
+    : file(std::move(mapped)), n(file->V()) {}
+
+bool GraphContext::symmetric() const {
+    return file ? !file->directed() : g->undirected();
+}
+
+void GraphContext::seed(Components components, std::pmr::vector<int> degrees) {
+    std::call_once(componentsOnce, [&] { cc = std::move(components); });
+    std::call_once(degreesOnce, [&] { deg = std::move(degrees); });
+}
+
+const std::pmr::vector<int>& GraphContext::degrees() {
+    std::call_once(degreesOnce, [this] {
+        deg.resize(n);
+        if (file) {
+            for (int u = 0; u < n; ++u) deg[u] = file->degree(u);
+            return;
+        }
+        const Graph::AdjList* adj = g->raw();
+        for (int u = 0; u < n; ++u) deg[u] = static_cast<int>(adj[u].size());
+    });
+    return deg;
+}
+
+const CSRView& GraphContext::csr() {
+    std::call_once(csrOnce, [this] {
+        if (file) csrView = CSRView{n, file->offsets(), file->targets()}; // zero-parse
+        else buildCSR();
+    });
+    return csrView;
+}
+
+const CSRView& GraphContext::transpose() {
+    std::call_once(transposeOnce, [this] { buildTranspose(); });
+    return transposeView;
+}
+
+const Components& GraphContext::components() {
+    std::call_once(componentsOnce, [this] { buildComponents(); });
+    return cc;
+}
+
+const SCCDecomposition& GraphContext::scc() {
+    std::call_once(sccOnce, [this] { buildSCC(); });
+    return sccs;
+}
+
+const BitMatrix& GraphContext::matrix() {
+    std::call_once(matrixOnce, [this] { buildMatrix(); });
+    return adjMatrix;
+}
+
+const GomoryHuTree& GraphContext::gomoryHu() {
+    std::call_once(gomoryHuOnce, [this] { buildGomoryHu(csr(), ght); });
+    return ght;
+}
+
+const GraphStats& GraphContext::stats() {
+    std::call_once(statsOnce, [this] {
+        const std::pmr::vector<int>& d = degrees();
+        shape.vertices = n;
+        shape.symmetric = symmetric();
+        for (int u = 0; u < n; ++u) {
+            shape.arcs += d[u];
+            shape.maxDegree = std::max(shape.maxDegree, d[u]);
+        }
+        if (n > 1) shape.density = static_cast<double>(shape.arcs) / (static_cast<double>(n) * (n - 1));
+        if (n > 0) shape.avgDegree = static_cast<double>(shape.arcs) / n;
+        if (shape.arcs > 0) shape.degreeSkew = shape.maxDegree / shape.avgDegree;
+    });
+    return shape;
+}
+
+// Flatten the adjacency lists into one offsets array and one targets array
+void GraphContext::buildCSR() {
+    const std::pmr::vector<int>& d = degrees();
+    const Graph::AdjList* adj = g->raw();
+
+    csrOffsets.assign(n + 1, 0);
+    for (int u = 0; u < n; ++u) csrOffsets[u + 1] = csrOffsets[u] + d[u];
+
+    csrTargets.resize(static_cast<size_t>(csrOffsets[n]));
+    for (int u = 0; u < n; ++u) {
+        std::copy(adj[u].begin(), adj[u].end(), csrTargets.begin() + csrOffsets[u]);
+    }
+    csrView = CSRView{n, csrOffsets.data(), csrTargets.data()};
+}
+
+// Reverse every arc; sources stay in ascending order within each list
+void GraphContext::buildTranspose() {
+    const CSRView& f = csr();
+    const int n = f.n;
+
+    transposeOffsets.assign(n + 1, 0);
+    for (int u = 0; u < n; ++u)
+        for (const int* p = f.begin(u); p != f.end(u); ++p) ++transposeOffsets[*p + 1];
+    for (int v = 0; v < n; ++v) transposeOffsets[v + 1] += transposeOffsets[v];
+
+    transposeTargets.resize(static_cast<size_t>(f.arcs()));
+    Workspace::Scope scope;
+    int64_t* fill = scope.take<int64_t>(n);
+    std::copy(transposeOffsets.begin(), transposeOffsets.begin() + n, fill);
+    for (int u = 0; u < n; ++u)
+        for (const int* p = f.begin(u); p != f.end(u); ++p) transposeTargets[fill[*p]++] = u;
+
+    transposeView = CSRView{n, transposeOffsets.data(), transposeTargets.data()};
+}
+
+// Afforest over the CSR; labels are the smallest vertex of each component,
+// so numbering the roots in vertex order matches the sequential union-find
+void GraphContext::buildComponents() {
+    const CSRView& f = csr();
+    const int n = f.n;
+    Workspace::Scope scope;
+    int* label = scope.take<int>(n);
+    cc.count = connectedComponents(n, f.offsets, f.targets, symmetric(), label);
+
+    cc.id.assign(n, -1);
+    int next = 0;
+    for (int u = 0; u < n; ++u) {
+        if (label[u] == u) cc.id[u] = next++;
+        cc.id[u] = cc.id[label[u]];
+    }
+}
+
+// Iterative Kosaraju; visits vertices in the same order as the recursive version
+void GraphContext::buildSCC() {
+    const CSRView& f = csr();
+    const CSRView& r = transpose();
+    const int n = f.n;
+    if (n + f.arcs() >= SCC_PARALLEL_MIN_WORK && std::thread::hardware_concurrency() > 1) {
+        buildSCCParallel();
+        return;
+    }
+
+    struct Frame { int u; int64_t next; }; // DFS stack entry: vertex and next arc
+
+    Workspace::Scope scope;
+    char* seen = scope.take<char>(n, 0);
+    int* order = scope.take<int>(n);
+    Frame* st = scope.take<Frame>(n);
+    int done = 0, top = 0;
+
+    // First pass: vertices by increasing finish time
+    for (int s = 0; s < n; ++s) {
+        if (seen[s]) continue;
+        seen[s] = 1;
+        st[top++] = {s, f.offsets[s]};
+        while (top) {
+            Frame& fr = st[top - 1];
+            if (fr.next < f.offsets[fr.u + 1]) {
+                int v = f.targets[fr.next++];
+                if (!seen[v]) { seen[v] = 1; st[top++] = {v, f.offsets[v]}; }
+            } else {
+                order[done++] = fr.u;
+                --top;
+            }
+        }
+    }
+
+    // Second pass on the transpose, in decreasing finish time
+    std::fill(seen, seen + n, 0);
+    sccs.comp.assign(n, -1);
+    sccs.start.assign(1, 0);
+    sccs.members.clear();
+    sccs.members.reserve(n);
+    sccs.count = 0;
+
+    for (int i = n - 1; i >= 0; --i) {
+        int s = order[i];
+        if (seen[s]) continue;
+        seen[s] = 1;
+        sccs.comp[s] = sccs.count;
+        sccs.members.push_back(s);
+        st[top++] = {s, r.offsets[s]};
+        while (top) {
+            Frame& fr = st[top - 1];
+            if (fr.next < r.offsets[fr.u + 1]) {
+                int v = r.targets[fr.next++];
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    sccs.comp[v] = sccs.count;
+                    sccs.members.push_back(v);
+                    st[top++] = {v, r.offsets[v]};
+                }
+            } else {
+                --top;
+            }
+        }
+        ++sccs.count;
+        sccs.start.push_back(static_cast<int>(sccs.members.size()));
+    }
+}
+
+// Forward-backward engine; components numbered by smallest vertex so the
+// result does not depend on thread timing
+void GraphContext::buildSCCParallel() {
+    const CSRView& f = csr();
+    const CSRView& r = transpose();
+    const int n = f.n;
+    Workspace::Scope scope;
+    int* label = scope.take<int>(n);
+    sccs.count = stronglyConnectedComponents(n, f.offsets, f.targets, r.offsets, r.targets, label);
+
+    // Counting sort of the vertices by component
+    sccs.comp.assign(n, -1);
+    sccs.start.assign(sccs.count + 1, 0);
+    int next = 0;
+    for (int u = 0; u < n; ++u) {
+        if (label[u] == u) sccs.comp[u] = next++;
+        sccs.comp[u] = sccs.comp[label[u]];
+        ++sccs.start[sccs.comp[u] + 1];
+    }
+    for (int c = 0; c < sccs.count; ++c) sccs.start[c + 1] += sccs.start[c];
+    sccs.members.resize(n);
+    int* fill = scope.take<int>(sccs.count);
+    std::copy(sccs.start.begin(), sccs.start.begin() + sccs.count, fill);
+    for (int u = 0; u < n; ++u) sccs.members[fill[sccs.comp[u]]++] = u;
+}
+
+void GraphContext::buildMatrix() {
+    const CSRView& f = csr();
+    adjMatrix.reset(f.n);
+    for (int u = 0; u < f.n; ++u)
+        for (const int* p = f.begin(u); p != f.end(u); ++p) adjMatrix.set(u, *p);
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+#include "Graph.h"
+#include "GraphFile.h"
+#include "BitMatrix.h"
+
+/**
+ * Compressed sparse row view of a graph's arcs.
+ * Neighbours of u are targets[offsets[u] .. offsets[u+1]).
+ */
+struct CSRView {
+    int n = 0;
+    const int64_t* offsets = nullptr;
+    const int* targets = nullptr;
+
+    int64_t arcs() const { return n ? offsets[n] : 0; }
+    int degree(int u) const { return static_cast<int>(offsets[u + 1] - offsets[u]); }
+    const int* begin(int u) const { return targets + offsets[u]; }
+    const int* end(int u) const { return targets + offsets[u + 1]; }
+};
+
+// Connected components, ignoring edge direction
+struct Components {
+    int count = 0;
+    std::pmr::vector<int> id; // component of each vertex
+
+    explicit Components(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) : id(mr) {}
+};
+
+/**
+ * Strongly connected components.
+ * Members of component c are members[start[c] .. start[c+1]).
+ * Small graphs keep Kosaraju's order; graphs large enough for the parallel
+ * engine (StronglyConnected.h) list components by smallest vertex and each
+ * component's members in increasing order.
+ */
+struct SCCDecomposition {
+    int count = 0;
+    std::pmr::vector<int> comp;    // component of each vertex
+    std::pmr::vector<int> start;   // size count+1
+    std::pmr::vector<int> members; // vertices grouped by component
+
+    explicit SCCDecomposition(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : comp(mr), start(mr), members(mr) {}
+};
+
+/**
+ * Gomory–Hu tree of an undirected unit-capacity graph (GomoryHu.h).
+ * Vertex u > 0 hangs under parent[u] < u by a tree edge of weight
+ * weight[u]; the minimum s-t cut equals the lightest edge on the s-t path.
+ */
+struct GomoryHuTree {
+    std::pmr::vector<int> parent;     // parent[0] = 0, the root
+    std::pmr::vector<int64_t> weight; // cut between u and parent[u]
+    std::pmr::vector<int> depth;      // edges from the root
+
+    explicit GomoryHuTree(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : parent(mr), weight(mr), depth(mr) {}
+
+    // Minimum s-t cut (max flow) in O(path length)
+    int64_t minCut(int s, int t) const;
+};
+
+// Cheap shape statistics, enough to estimate what an algorithm will cost
+struct GraphStats {
+    int vertices = 0;
+    int64_t arcs = 0;
+    double density = 0;    // arcs / (n (n - 1))
+    double avgDegree = 0;  // out-arcs per vertex
+    int maxDegree = 0;
+    double degreeSkew = 0; // maxDegree / avgDegree; 1 for a regular graph
+    bool symmetric = false;
+};
+
+/**
+ * Lazily-populated analysis of one graph, shared by every algorithm that
+ * runs on it (e.g. the four workers of an "all" request).
+ *
+ * Each artifact is computed at most once, on first request, and is safe to
+ * request concurrently from several threads. Artifacts are allocated from
+ * the graph's memory resource (the request arena in the server).
+ *
+ * A context can also wrap a memory-mapped .graph file; its CSR is then the
+ * file's own arrays and nothing is parsed or copied.
+ */
+class GraphContext {
+public:
+    // Share ownership of the graph (and optionally of the arena it lives in)
+    explicit GraphContext(std::shared_ptr<const Graph> g,
+                          std::shared_ptr<std::pmr::memory_resource> arena = nullptr);
+    // Borrow a graph that outlives the context
+    explicit GraphContext(const Graph& g);
+    // Use a mapped .graph file directly
+    explicit GraphContext(std::shared_ptr<const MappedGraph> file);
+
+    GraphContext(const GraphContext&) = delete;
+    GraphContext& operator=(const GraphContext&) = delete;
+
+    int V() const { return n; }
+
+    // True when every arc u->v has a matching v->u (an undirected graph)
+    bool symmetric() const;
+
+    // Install artifacts computed elsewhere (e.g. while the edges were being
+    // received) so they are not rebuilt. Call before the context is shared.
+    void seed(Components components, std::pmr::vector<int> degrees);
+
+    const std::pmr::vector<int>& degrees();
+    const CSRView& csr();
+    const CSRView& transpose();
+    const Components& components();
+    const SCCDecomposition& scc();
+    const BitMatrix& matrix();
+    const GomoryHuTree& gomoryHu(); // undirected graphs only
+    const GraphStats& stats();      // from the degrees, O(n)
+
+private:
+    std::shared_ptr<std::pmr::memory_resource> arena; // declared first: released last
+    std::shared_ptr<const Graph> g;          // set for in-memory graphs
+    std::shared_ptr<const MappedGraph> file; // set for mapped files
+    int n;
+
+    std::once_flag degreesOnce, csrOnce, transposeOnce, componentsOnce, sccOnce, matrixOnce, gomoryHuOnce,
+                   statsOnce;
+
+    std::pmr::vector<int> deg;
+    CSRView csrView, transposeView;
+    std::pmr::vector<int64_t> csrOffsets, transposeOffsets;
+    std::pmr::vector<int> csrTargets, transposeTargets;
+    Components cc;
+    SCCDecomposition sccs;
+    BitMatrix adjMatrix;
+    GomoryHuTree ght;
+    GraphStats shape;
+
+    void buildCSR();
+    void buildTranspose();
+    void buildComponents();
+    void buildSCC();
+    void buildSCCParallel();
+    void buildMatrix();
+};
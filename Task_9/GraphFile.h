@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * Binary graph file format (".graph"), designed to be mmap'ed and used as-is.
+ *
+ * Layout (all integers little-endian, host byte order):
+ *
+ *   offset 0      GraphFileHeader (64 bytes)
+ *   offsetsPos    int64_t offsets[vertices + 1]   (64-byte aligned)
+ *   targetsPos    int32_t targets[arcs]           (64-byte aligned)
+ *
+ * This is a CSR (compressed sparse row) layout: the neighbours of u are
+ * targets[offsets[u] .. offsets[u+1]). For an undirected graph every edge is
+ * stored as two arcs (u->v and v->u) and flag GRAPH_FILE_DIRECTED is clear.
+ *
+ * Opening a file checks the header, that offsets never decrease and that
+ * every target is a vertex, one pass over the arrays; after that they are
+ * used straight from the mapping, with no parsing or copying. The server
+ * keeps validated mappings, so a file is checked once per version.
+ */
+constexpr char     GRAPH_FILE_MAGIC[8] = {'O', 'S', 'G', 'R', 'A', 'P', 'H', '1'};
+constexpr uint32_t GRAPH_FILE_VERSION  = 1;
+constexpr uint32_t GRAPH_FILE_DIRECTED = 1u << 0;
+
+struct GraphFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t vertices;
+    uint64_t edges;      // edges in the source edge list
+    uint64_t arcs;       // entries in targets[]
+    uint64_t offsetsPos; // byte position of offsets[]
+    uint64_t targetsPos; // byte position of targets[]
+    uint64_t reserved;
+};
+static_assert(sizeof(GraphFileHeader) == 64, "header must stay 64 bytes");
+
+/**
+ * Read-only mapping of a .graph file.
+ * Throws std::runtime_error if the file is missing, truncated or malformed.
+ */
+class MappedGraph {
+public:
+    explicit MappedGraph(const std::string& path);
+    ~MappedGraph();
+
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+
+    const GraphFileHeader& header() const { return *hdr; }
+    int V() const { return static_cast<int>(hdr->vertices); }
+    bool directed() const { return hdr->flags & GRAPH_FILE_DIRECTED; }
+    const int64_t* offsets() const { return offs; }
+    const int32_t* targets() const { return tgts; }
+    int degree(int u) const { return static_cast<int>(offs[u + 1] - offs[u]); }
+
+    // Last modification time of the file (nanoseconds) and its size, for cache keys
+    int64_t modified() const { return mtime; }
+    size_t size() const { return mapSize; }
+
+private:
+    void* map;
+    size_t mapSize;
+    int64_t mtime;
+    const GraphFileHeader* hdr;
+    const int64_t* offs;
+    const int32_t* tgts;
+};
+
+/**
+ * Write a .graph file from an edge list given as flat endpoint pairs
+ * (u0, v0, u1, v1, ...). Undirected graphs store both arc directions.
+ * Throws std::runtime_error on I/O failure or out-of-range endpoints.
+ */
+void writeGraphFile(const std::string& path, int vertices,
+                    const int32_t* endpoints, size_t edgeCount, bool directed);
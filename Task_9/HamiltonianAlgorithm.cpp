@@ -1,86 +1,249 @@
 #include "HamiltonianAlgorithm.h"
 #include "Graph.h"
+#include "Workspace.h"
+#include "HamiltonianKernels.h"
+#include <algorithm>
+#include <random>
 #include <vector>
-#include <sstream>
-
-// Build an adjacency matrix so we can check if an edge exists in O(1).
-static std::vector<std::vector<char>> buildAdjMatrix(const Graph& g) {
-    int n = g.V();
-    const std::vector<int>* adj = g.raw();
-    std::vector<std::vector<char>> A(n, std::vector<char>(n, 0));
-    for (int u = 0; u < n; ++u) {
-        for (int v : adj[u]) A[u][v] = 1;
-    }
-    return A;
-}
 
+// Scratch rows for the search, each A.words long and 64-byte aligned
+struct SearchRows {
+    uint64_t* unplaced; // vertices not on the path yet
+    uint64_t* cand;     // one candidate row per path position
+    uint64_t* reached;  // reach() output
+    uint64_t* frontier; // reach() scratch
+};
+
+// General backtracker for graphs above HAMILTON_FIXED_MAX_VERTICES.
 // Backtracking helper: try to place vertex at position `pos` in path.
 // path[0] is fixed to 0 to avoid counting rotations of the same cycle.
-// `used[v]` marks if v is already in the path.
+// Candidates are row[last] & unplaced, computed a row at a time and
+// visited in increasing vertex order.
 // If we manage to place all vertices and there’s an edge back to the start,
 // we’ve found a Hamiltonian cycle.
-static bool backtrackHamilton(
-    const std::vector<std::vector<char>>& A,
-    std::vector<int>& path,
-    std::vector<char>& used,
-    int pos
-) {
-    const int n = (int)A.size();
+static bool backtrackHamilton(const BitMatrix& A, int* path, const SearchRows& r, int pos) {
+    const int n = A.n;
+    const int W = A.words;
+    const int last = path[pos - 1];
     if (pos == n) {
         // All vertices are placed, now check if the last one connects back to 0.
-        return A[path[n - 1]][path[0]] != 0;
+        return A.test(last, path[0]);
     }
 
-    // Try every possible next vertex
-    for (int v = 1; v < n; ++v) // skip 0 since it's already fixed at start
-    {
-        if (!used[v] && A[path[pos - 1]][v]) {
-            used[v] = 1;
-            path[pos] = v;
-            if (backtrackHamilton(A, path, used, pos + 1)) return true;
-            used[v] = 0; // undo choice if it didn’t work
+    // Dense connectivity check: every unplaced vertex must still be reachable
+    // from the end of the path through unplaced vertices
+    if (n - pos >= HAMILTON_PRUNE_MIN_LEFT) {
+        A.reach(last, r.unplaced, r.reached, r.frontier);
+        if (!bitrow::subset(r.unplaced, r.reached, W)) return false;
+    }
+
+    uint64_t* cand = r.cand + static_cast<size_t>(pos) * W;
+    bitrow::intersect(A.row(last), r.unplaced, cand, W);
+    for (int v = bitrow::firstSet(cand, W); v != -1; v = bitrow::nextSet(cand, W, v + 1)) {
+        r.unplaced[v >> 6] &= ~(1ULL << (v & 63));
+        path[pos] = v;
+        if (backtrackHamilton(A, path, r, pos + 1)) return true;
+        r.unplaced[v >> 6] |= 1ULL << (v & 63); // undo choice if it didn’t work
+    }
+    return false;
+}
+
+constexpr int POSA_MIN_VERTICES = 24; // smaller graphs go straight to the exact search
+constexpr int POSA_RESTARTS = 2;
+constexpr int64_t POSA_WORK_PER_ARC = 512; // work budget per restart, per vertex and arc
+
+// Randomised Pósa rotation-extension for undirected graphs.
+// Grows a path from a random vertex: while the end has an unvisited
+// neighbour the path is extended, otherwise a random neighbour p[i] of the
+// end is chosen and the part after p[i] is reversed, giving a new end.
+// Once every vertex is on the path, it closes into a cycle as soon as the
+// end is adjacent to the start, or to some p[i] whose successor p[i+1] is
+// adjacent to the start (rotate around p[i], then close). Each restart stops
+// after a budget of work (neighbours scanned + vertices moved), so a
+// hopeless graph costs O(restarts * (V + E)) before the exact search runs.
+// On success path[0..n) is a Hamiltonian cycle starting at 0.
+static bool posaHamilton(const CSRView& G, int* path) {
+    const int n = G.n;
+    Workspace::Scope scope;
+    int* p = scope.take<int>(n);  // current path
+    int* at = scope.take<int>(n); // position of each vertex on it, -1 if absent
+    char* nearStart = scope.take<char>(n, 0); // neighbours of p[0]
+    std::mt19937 rng(0x9e3779b9u ^ static_cast<uint32_t>(n)); // fixed: same graph, same answer
+    const int64_t budget = POSA_WORK_PER_ARC * (n + G.arcs());
+
+    // Reverse p[from..len) and fix the positions
+    auto rotate = [&](int from, int len) {
+        std::reverse(p + from, p + len);
+        for (int j = from; j < len; ++j) at[p[j]] = j;
+    };
+
+    for (int attempt = 0; attempt < POSA_RESTARTS; ++attempt) {
+        std::fill(at, at + n, -1);
+        int len = 0;
+        const int start = static_cast<int>(rng() % n);
+        p[len] = start;
+        at[start] = len++;
+        for (const int* q = G.begin(start); q != G.end(start); ++q) nearStart[*q] = 1;
+
+        int closeAt = -1; // rotate around p[closeAt] to close the cycle; n - 1 = already closed
+        for (int64_t work = 0; work < budget && closeAt < 0;) {
+            const int end = p[len - 1];
+            const int* nb = G.begin(end);
+            const int d = G.degree(end);
+            work += d;
+
+            if (len == n) {
+                if (nearStart[end]) { closeAt = n - 1; break; }
+                for (int k = 0; k < d; ++k) {
+                    int i = at[nb[k]];
+                    if (i < n - 2 && nearStart[p[i + 1]]) { closeAt = i; break; }
+                }
+                if (closeAt >= 0) break;
+            }
+
+            // Extension: first unvisited neighbour, scanning from a random offset
+            const int off = static_cast<int>(rng() % d);
+            int next = -1;
+            for (int i = 0; i < d && len < n; ++i) {
+                int v = nb[(off + i) % d];
+                if (at[v] < 0) { next = v; break; }
+            }
+            if (next >= 0) {
+                p[len] = next;
+                at[next] = len++;
+                continue;
+            }
+
+            // Rotation around a random neighbour; the end's predecessor gives the same path
+            const int i = at[nb[off]];
+            if (i >= len - 2) continue;
+            rotate(i + 1, len);
+            work += len - i;
         }
+
+        for (const int* q = G.begin(start); q != G.end(start); ++q) nearStart[*q] = 0;
+        if (closeAt < 0) continue;
+
+        // Closed: p[0..i], p[n-1], ..., p[i+1] is a cycle; list it from vertex 0
+        rotate(closeAt + 1, n);
+        const int shift = at[0];
+        for (int i = 0; i < n; ++i) path[i] = p[(shift + i) % n];
+        return true;
     }
     return false;
 }
 
-std::string HamiltonianAlgorithm::run(const Graph& g) {
-    std::ostringstream out;
-    const int n = g.V();
+// Held–Karp style dynamic programme over vertex subsets, for graphs of at
+// most HAMILTON_DP_MAX_VERTICES vertices. For a set R of vertices other
+// than 0, good[R] holds the w in R from which a path can cover R \ {w} and
+// end next to 0. Walking forward from 0 and always taking the smallest good
+// neighbour then yields the same cycle as the backtracking search (the
+// lexicographically first one). O(2^n * n) time, 2^(n-1) words of memory.
+static bool heldKarpHamilton(const BitMatrix& A, int* path) {
+    const int n = A.n;
+    uint32_t out[HAMILTON_DP_MAX_VERTICES]; // out-neighbours of each vertex as a bit set
+    for (int u = 0; u < n; ++u) out[u] = static_cast<uint32_t>(A.row(u)[0]);
+
+    // Tables are indexed by R >> 1 (vertex 0 is never in R)
+    Workspace::Scope scope;
+    const uint32_t all = (1u << n) - 2u;
+    uint32_t* good = scope.take<uint32_t>((all >> 1) + 1);
+    auto closes = [&](int w, uint32_t rest) { // w covers `rest` and returns to 0
+        return rest == 0 ? (out[w] & 1u) != 0 : (out[w] & good[rest >> 1]) != 0;
+    };
+    good[0] = 0;
+    for (uint32_t R = 2; R <= all; R += 2) {
+        uint32_t g = 0;
+        for (uint32_t left = R; left; left &= left - 1) {
+            const int w = __builtin_ctz(left);
+            if (closes(w, R & ~(1u << w))) g |= 1u << w;
+        }
+        good[R >> 1] = g;
+    }
+    if (!closes(0, all)) return false;
+
+    path[0] = 0;
+    uint32_t R = all;
+    for (int pos = 1; pos < n; ++pos) {
+        const int v = __builtin_ctz(out[path[pos - 1]] & good[R >> 1]);
+        path[pos] = v;
+        R &= ~(1u << v);
+    }
+    return true;
+}
+
+// Set up the scratch rows and run the general backtracker
+static bool searchGeneral(const BitMatrix& A, int* path) {
+    const int n = A.n;
+    const size_t W = A.words;
+    Workspace::Scope scope;
+    SearchRows rows{
+        scope.takeAligned<uint64_t>(W, 64),
+        scope.takeAligned<uint64_t>(W * n, 64),
+        scope.takeAligned<uint64_t>(W, 64),
+        scope.takeAligned<uint64_t>(W, 64),
+    };
+    std::fill(rows.unplaced, rows.unplaced + W, 0);
+    for (int v = 1; v < n; ++v) rows.unplaced[v >> 6] |= 1ULL << (v & 63);
+
+    path[0] = 0; // Fix start to 0 (break rotational symmetry)
+    return backtrackHamilton(A, path, rows, 1);
+}
+
+AlgorithmResult HamiltonianAlgorithm::compute(GraphContext& ctx, const Options& opts) {
+    const int n = ctx.V();
+    CycleResult r;
+    r.vertices = n;
 
-    if (n == 0) { out << "No Hamiltonian circuit (empty graph)\n"; return out.str(); }
-    if (n == 1) { out << "Hamiltonian circuit: 0 -> 0\n"; return out.str(); }
+    auto it = opts.find("strategy");
+    const std::string strategy = it == opts.end() ? "auto" : it->second;
+    if (strategy != "auto" && strategy != "posa" && strategy != "exact" && strategy != "dp")
+        return ErrorResult{"Error: unknown hamilton strategy " + strategy + "\n"};
+    if (strategy == "dp" && n > HAMILTON_DP_MAX_VERTICES)
+        return ErrorResult{"Error: strategy=dp handles at most " + std::to_string(HAMILTON_DP_MAX_VERTICES) +
+                           " vertices\n"};
 
-    auto A = buildAdjMatrix(g);
+    if (n == 0) return r;
+    if (n == 1) { r.found = true; r.cycle.assign(1, 0); return r; }
 
     // For an undirected Hamiltonian cycle, every vertex should have degree >= 2 (this isn’t a complete test).
     {
-        const std::vector<int>* adj = g.raw();
+        const std::pmr::vector<int>& deg = ctx.degrees();
+        const int minDeg = ctx.symmetric() && n > 2 ? 2 : 1; // the cycle enters and leaves each vertex
         bool obviouslyNo = false;
         for (int u = 0; u < n; ++u) 
         {
-            if ((int)adj[u].size() < 1) { obviouslyNo = true; break; }
-        }
-        if (obviouslyNo) {
-            out << "No Hamiltonian circuit\n";
-            return out.str();
+            if (deg[u] < minDeg) { obviouslyNo = true; break; }
         }
+        // A Hamiltonian cycle makes every vertex reachable from every other,
+        // so more than one SCC (shared with the SCC algorithm) rules it out.
+        if (!obviouslyNo && ctx.scc().count > 1) obviouslyNo = true;
+        if (obviouslyNo) return r;
     }
 
-    std::vector<int> path(n, -1);
-    std::vector<char> used(n, 0);
+    Workspace::Scope scope;
+    int* path = scope.take<int>(n, -1);
 
-    path[0] = 0; // Fix start to 0 (break rotational symmetry)
-    used[0] = 1;
+    if (strategy == "dp") {
+        r.found = heldKarpHamilton(ctx.matrix(), path);
+        if (r.found) r.cycle.assign(path, path + n);
+        return r;
+    }
 
-    if (backtrackHamilton(A, path, used, 1)) {
-        out << "Hamiltonian circuit: ";
-        for (int i = 0; i < n; ++i) {
-            out << path[i] << " ";
-        }
-        out << "0\n"; // close the cycle by returning to the start
-    } else {
-        out << "No Hamiltonian circuit\n";
+    // Heuristic first: on large undirected graphs a cycle usually exists and
+    // rotations find it in near-linear time
+    const bool tryPosa = strategy == "posa" || (strategy == "auto" && n >= POSA_MIN_VERTICES);
+    bool found = tryPosa && n > 2 && ctx.symmetric() && posaHamilton(ctx.csr(), path);
+
+    if (!found) {
+        // Exact search on the dense adjacency bitset from the context
+        const BitMatrix& A = ctx.matrix();
+        found = n <= HAMILTON_FIXED_MAX_VERTICES
+            ? hamiltonFixedWidth(A, path) // masks of 1, 2 or 4 words
+            : searchGeneral(A, path);
     }
-    return out.str();
+
+    r.found = found;
+    if (found) r.cycle.assign(path, path + n);
+    return r;
 }
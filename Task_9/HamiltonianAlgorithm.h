@@ -2,11 +2,27 @@
 #include "GraphAlgorithm.h"
 #include <string>
 
+// Largest graph the subset dynamic programme (strategy=dp) accepts
+constexpr int HAMILTON_DP_MAX_VERTICES = 20;
+
 /**
- * Hamiltonian Circuit algorithm (cycle) via simple backtracking.
+ * Hamiltonian Circuit algorithm (cycle).
+ *
+ * Undirected graphs with at least 24 vertices first get a bounded, seeded
+ * Pósa rotation-extension heuristic. If it gives up, an exact backtracking
+ * search decides (fixed-width bitmask kernels up to 256 vertices).
+ *
+ * Option strategy= pins the method:
+ *  - auto  (default) as above
+ *  - posa  the heuristic at any size (undirected graphs), then backtracking
+ *  - exact backtracking only
+ *  - dp    dynamic programme over vertex subsets, O(2^n n), for graphs of at
+ *          most HAMILTON_DP_MAX_VERTICES vertices; finds the same cycle as
+ *          backtracking
  */
 class HamiltonianAlgorithm : public GraphAlgorithm {
 public:
     std::string name() const override { return "hamilton"; }
-    std::string run(const Graph& g) override;
+    using GraphAlgorithm::run;
+    AlgorithmResult compute(GraphContext& ctx, const Options& opts) override;
 };
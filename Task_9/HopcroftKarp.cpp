@@ -0,0 +1,124 @@
+#include "HopcroftKarp.h"
+#include "Workspace.h"
+#include <climits>
+
+namespace {
+
+// Role flags of a vertex; left roles and right roles must not meet
+enum Role : char {
+    FROM_SOURCE = 1, // arc s -> u: a left vertex
+    TO_SINK = 2,     // arc u -> t: a right vertex
+    ARC_TAIL = 4,    // tail of an arc between two inner vertices
+    ARC_HEAD = 8,    // head of such an arc
+};
+constexpr char LEFT_ROLES = FROM_SOURCE | ARC_TAIL;
+constexpr char RIGHT_ROLES = TO_SINK | ARC_HEAD;
+
+// Give every vertex its roles; false if the network is not source -> L -> R -> sink.
+// Inner vertices without an arc from s or to t may appear; they carry no flow.
+bool classify(const CSRView& G, int s, int t, char* role, int64_t& direct) {
+    const int n = G.n;
+    direct = 0;
+    for (const int* p = G.begin(s); p != G.end(s); ++p) {
+        if (*p == t) { ++direct; continue; }
+        if (*p == s || (role[*p] & FROM_SOURCE)) return false; // parallel arcs: capacity above 1
+        role[*p] |= FROM_SOURCE;
+    }
+    for (int u = 0; u < n; ++u) {
+        if (u == s || u == t) continue;
+        for (const int* p = G.begin(u); p != G.end(u); ++p) {
+            const int v = *p;
+            if (v == s) continue; // into s: cannot carry s-t flow
+            if (v == t) {
+                if (role[u] & TO_SINK) return false;
+                role[u] |= TO_SINK;
+            } else {
+                role[u] |= ARC_TAIL;
+                role[v] |= ARC_HEAD;
+            }
+        }
+    }
+    for (int u = 0; u < n; ++u) {
+        if ((role[u] & LEFT_ROLES) && (role[u] & RIGHT_ROLES)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int64_t hopcroftKarpFlow(const CSRView& G, int s, int t) {
+    const int n = G.n;
+    if (s < 0 || t < 0 || s >= n || t >= n || s == t) return -1;
+
+    Workspace::Scope scope;
+    char* role = scope.take<char>(n, 0);
+    int64_t direct;
+    if (!classify(G, s, t, role, direct)) return -1;
+
+    int* matchL = scope.take<int>(n, -1); // right partner of a left vertex
+    int* matchR = scope.take<int>(n, -1); // left partner of a right vertex
+    int* dist = scope.take<int>(n);       // BFS layer of a left vertex
+    int* queue = scope.take<int>(n);
+    int* stack = scope.take<int>(n);
+    int64_t* next = scope.take<int64_t>(n); // next arc to try in the DFS
+
+    const int* left = G.begin(s);
+    const int leftCount = G.degree(s);
+    int64_t matched = 0;
+
+    for (;;) {
+        // BFS: layer the left vertices, starting from the free ones
+        int head = 0, tail = 0;
+        for (const int* p = left; p != left + leftCount; ++p) {
+            if (*p == t) continue;
+            dist[*p] = matchL[*p] == -1 ? 0 : INT_MAX;
+            if (dist[*p] == 0) queue[tail++] = *p;
+        }
+        bool reachesFree = false;
+        while (head < tail) {
+            int u = queue[head++];
+            for (const int* p = G.begin(u); p != G.end(u); ++p) {
+                if (!(role[*p] & TO_SINK)) continue;
+                int w = matchR[*p];
+                if (w == -1) reachesFree = true;
+                else if (dist[w] == INT_MAX) { dist[w] = dist[u] + 1; queue[tail++] = w; }
+            }
+        }
+        if (!reachesFree) break;
+
+        // DFS from every free left vertex along the layers; each success
+        // flips the path on the stack. Dead ends leave the layering.
+        for (const int* p = left; p != left + leftCount; ++p) {
+            if (*p != t) next[*p] = G.offsets[*p];
+        }
+        for (const int* p = left; p != left + leftCount; ++p) {
+            const int root = *p;
+            if (root == t || matchL[root] != -1) continue;
+            int top = 0;
+            stack[top++] = root;
+            while (top) {
+                const int u = stack[top - 1];
+                if (next[u] == G.offsets[u + 1]) { // exhausted
+                    dist[u] = INT_MAX;
+                    if (--top) ++next[stack[top - 1]];
+                    continue;
+                }
+                const int v = G.targets[next[u]];
+                const int w = (role[v] & TO_SINK) ? matchR[v] : -2;
+                if (w == -1) {
+                    // Free right vertex: augment along the stack
+                    for (int k = top - 1; k >= 0; --k) {
+                        int x = stack[k], y = G.targets[next[x]];
+                        matchL[x] = y;
+                        matchR[y] = x;
+                    }
+                    ++matched;
+                    break;
+                }
+                if (w >= 0 && dist[w] == dist[u] + 1) stack[top++] = w;
+                else ++next[u];
+            }
+        }
+    }
+    return matched + direct;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "GraphContext.h"
+
+/**
+ * Max flow of a bipartite unit-capacity network by Hopcroft–Karp matching.
+ *
+ * The network must have the shape source -> L -> R -> sink:
+ *  - every arc out of s goes to t or to a left vertex, at most once each
+ *  - every arc into t comes from s or a right vertex, at most once each
+ *  - every other arc goes from a left-side to a right-side vertex, and no
+ *    vertex is on both sides
+ * Arcs into s and out of t are ignored; they cannot carry s-t flow, and
+ * neither can left vertices without an arc from s or right vertices without
+ * an arc to t. The flow is then the size of a maximum matching between L
+ * and R (plus any direct s -> t arcs), which Hopcroft–Karp finds in
+ * O(E sqrt(V)): each phase layers the graph by BFS from the free left
+ * vertices and augments along a maximal set of vertex-disjoint shortest paths.
+ *
+ * The shape is checked first, in O(V + E); returns -1 if it does not hold.
+ */
+int64_t hopcroftKarpFlow(const CSRView& G, int s, int t);
@@ -12,5 +12,6 @@
 class MSTAlgorithm : public GraphAlgorithm {
 public:
     std::string name() const override { return "mst"; }
-    std::string run(const Graph& g) override;
+    using GraphAlgorithm::run;
+    AlgorithmResult compute(GraphContext& ctx, const Options& opts) override;
 };
@@ -1,79 +1,100 @@
 #include "MaxFlowAlgorithm.h"
+#include "EdmondsKarp.h"
+#include "HopcroftKarp.h"
+#include "PushRelabel.h"
 #include "Graph.h"
+#include <algorithm>
+#include <charconv>
+#include <thread>
 
-#include <vector>
-#include <queue>
-#include <limits>
-#include <sstream>
-
-static int edmondsKarp_unitCap(const Graph& G, int s, int t) {
-    const int n = G.V();
-    if (n == 0 || s < 0 || t < 0 || s >= n || t >= n) return 0;
-    if (s == t) return 0;
-
-    // Build capacity matrix from Graph adjacency: each edge contributes capacity 1
-    const std::vector<int>* adj = G.raw();
-    std::vector<std::vector<int>> cap(n, std::vector<int>(n, 0));
-    for (int u = 0; u < n; ++u) {
-        for (int v : adj[u]) {
-            // parallel edges sum capacities
-            ++cap[u][v];
-        }
-    }
-
-    int maxflow = 0;
-    std::vector<int> parent(n, -1);
+// Parse a vertex id; false unless the whole text is a number in [0, n)
+static bool parseVertex(const std::string& text, int n, int& v) {
+    const char* end = text.data() + text.size();
+    auto [p, ec] = std::from_chars(text.data(), end, v);
+    return ec == std::errc() && p == end && v >= 0 && v < n;
+}
 
-    auto bfs = [&](int source, int sink) -> int {
-        std::fill(parent.begin(), parent.end(), -1);
-        parent[source] = -2;  // sentinel
-        std::queue<std::pair<int,int>> q; // (vertex, bottleneck so far)
-        q.push({source, std::numeric_limits<int>::max()});
+AlgorithmResult MaxFlowAlgorithm::compute(GraphContext& ctx, const Options& opts) {
+    const int n = ctx.V();
+    auto option = [&](const char* key, const std::string& fallback) {
+        auto it = opts.find(key);
+        return it == opts.end() ? fallback : it->second;
+    };
 
-        while (!q.empty()) {
-            int u = q.front().first;
-            int flow_so_far = q.front().second;
-            q.pop();
+    const std::string method = option("method", "auto");
+    if (method != "auto" && method != "tree" && method != "ek" && method != "matching" &&
+        method != "pushrelabel")
+        return ErrorResult{"Error: unknown maxflow method " + method + "\n"};
+    const std::string engine = option("engine", "");
+    if (!engine.empty() && engine != "ek" && engine != "pushrelabel")
+        return ErrorResult{"Error: unknown maxflow engine " + engine + "\n"};
+    if (method == "tree" && !ctx.symmetric())
+        return ErrorResult{"Error: method=tree needs an undirected graph\n"};
 
-            for (int v = 0; v < n; ++v) {
-                if (parent[v] == -1 && cap[u][v] > 0) {
-                    parent[v] = u;
-                    int new_flow = std::min(flow_so_far, cap[u][v]);
-                    if (v == sink) return new_flow;
-                    q.push({v, new_flow});
-                }
-            }
+    // One s-t flow: Hopcroft–Karp when the network is a bipartite matching
+    // (source -> L -> R -> sink), otherwise the engine asked for, by default
+    // push–relabel on large networks and Edmonds–Karp on small ones; -1 if
+    // "matching" was asked for and the shape does not hold. An undirected
+    // graph has every L -> R arc backwards too, so "auto" skips the check.
+    auto flow = [&](int s, int t) -> int64_t {
+        if (method == "pushrelabel") return pushRelabelFlow(ctx.csr(), s, t);
+        if (method != "ek") {
+            int64_t f = method == "matching" || !ctx.symmetric() ? hopcroftKarpFlow(ctx.csr(), s, t) : -1;
+            if (f >= 0 || method == "matching") return f;
+            const bool large = ctx.csr().arcs() >= PUSH_RELABEL_MIN_ARCS;
+            if (engine == "pushrelabel" || (engine.empty() && large)) return pushRelabelFlow(ctx.csr(), s, t);
         }
-        return 0; // no augmenting path
+        return edmondsKarp_unitCap(ctx.csr(), s, t);
+    };
+    auto notBipartite = [](const FlowResult& f) {
+        return ErrorResult{"Error: " + std::to_string(f.source) + "->" + std::to_string(f.sink) +
+                           " is not a bipartite unit-capacity network\n"};
     };
 
-    while (true) {
-        int aug = bfs(s, t);
-        if (aug == 0) break; // no more augmenting paths
+    auto batch = opts.find("pairs");
+    if (batch == opts.end()) {
+        FlowResult r;
+        r.source = 0;
+        r.sink = n - 1;
+        if (opts.count("source") && !parseVertex(option("source", ""), n, r.source))
+            return ErrorResult{"Error: bad maxflow source " + option("source", "") + "\n"};
+        if (opts.count("sink") && !parseVertex(option("sink", ""), n, r.sink))
+            return ErrorResult{"Error: bad maxflow sink " + option("sink", "") + "\n"};
+        if (n <= 1) return r;
 
-        maxflow += aug;
-        // backtrack and update residual capacities
-        int v = t;
-        while (v != s) {
-            int u = parent[v];
-            cap[u][v] -= aug;
-            cap[v][u] += aug;
-            v = u;
-        }
+        r.value = method == "tree" ? ctx.gomoryHu().minCut(r.source, r.sink) : flow(r.source, r.sink);
+        if (r.value < 0) return notBipartite(r);
+        return r;
     }
 
-    return maxflow;
-}
-
-std::string MaxFlowAlgorithm::run(const Graph& g) {
-    std::ostringstream out;
-    const int n = g.V();
-    if (n <= 1) {
-        out << "Max flow (0->" << n-1 << ", unit capacities): 0\n";
-        return out.str();
+    // pairs=s-t,s-t,...
+    FlowTableResult table;
+    const std::string& list = batch->second;
+    for (size_t at = 0; at <= list.size();) {
+        size_t comma = std::min(list.find(',', at), list.size());
+        std::string item = list.substr(at, comma - at);
+        size_t dash = item.find('-');
+        FlowResult f;
+        if (dash == std::string::npos || !parseVertex(item.substr(0, dash), n, f.source) ||
+            !parseVertex(item.substr(dash + 1), n, f.sink))
+            return ErrorResult{"Error: bad maxflow pair " + item + "\n"};
+        table.flows.push_back(f);
+        at = comma + 1;
     }
 
-    int flow = edmondsKarp_unitCap(g, 0, n-1); // (graph,source,sink)
-    out << "Max flow (0->" << (n-1) << ", unit capacities): " << flow << "\n";
-    return out.str();
+    // The tree costs n - 1 flows spread over all cores; the batch one flow per pair
+    const int64_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const bool tree = method == "tree" ||
+        (method == "auto" && ctx.symmetric() && static_cast<int64_t>(table.flows.size()) * cores >= n - 1);
+
+    if (tree) {
+        const GomoryHuTree& gh = ctx.gomoryHu();
+        for (FlowResult& f : table.flows) f.value = gh.minCut(f.source, f.sink);
+    } else {
+        for (FlowResult& f : table.flows) {
+            f.value = f.source == f.sink ? 0 : flow(f.source, f.sink);
+            if (f.value < 0) return notBipartite(f);
+        }
+    }
+    return table;
 }
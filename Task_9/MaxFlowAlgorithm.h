@@ -4,14 +4,36 @@
 
 /**
  * Max Flow from source=0 to sink=n-1 using Edmonds–Karp (unit capacities).
+ * Networks that are really bipartite matchings (source -> L -> R -> sink,
+ * see HopcroftKarp.h) are detected and solved by Hopcroft–Karp instead, and
+ * large networks go to the parallel push–relabel engine (PushRelabel.h).
+ * The matching shape needs one-way arcs, so only directed graphs (.graph
+ * files written as directed) are checked for it; uploads are undirected
+ * and never pay for the check.
  *
  * Assumptions:
  *  - The Graph's adjacency is interpreted as directed edges.
  *  - Each edge has capacity 1 (parallel edges add capacity).
  *  - If you used addEdge(u,v) for undirected graphs, you'll get capacity both ways.
+ *
+ * Options:
+ *  - source=<s> sink=<t>     another pair than 0 -> n-1
+ *  - pairs=<s>-<t>,<s>-<t>   a batch of pairs, answered in order
+ *  - method=auto|tree|ek|matching|pushrelabel   how pairs are answered.
+ *    "tree" builds the graph's Gomory–Hu tree (undirected graphs only,
+ *    n - 1 flows in parallel, kept in the GraphContext) and reads every
+ *    pair off it; "ek" runs plain Edmonds–Karp per pair; "matching" insists
+ *    on the bipartite engine and fails if the shape does not hold;
+ *    "pushrelabel" runs push–relabel per pair. "auto" (default) takes the
+ *    tree for a batch on an undirected graph that costs at least as much as
+ *    the tree, and otherwise runs one flow per pair, bipartite-detected,
+ *    with push–relabel from PUSH_RELABEL_MIN_ARCS arcs on.
+ *  - engine=ek|pushrelabel   the engine "auto" uses for networks that are
+ *    not bipartite, whatever their size
  */
 class MaxFlowAlgorithm : public GraphAlgorithm {
 public:
     std::string name() const override { return "maxflow"; }
-    std::string run(const Graph& g) override;
+    using GraphAlgorithm::run;
+    AlgorithmResult compute(GraphContext& ctx, const Options& opts) override;
 };
@@ -0,0 +1,237 @@
+#include "PushRelabel.h"
+#include "ThreadPool.h"
+#include "Workspace.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t BLOCK = 64;         // active vertices per scheduling block
+constexpr int64_t RELABEL_COST = 12; // work charged per relabel on top of the arc scan
+
+// Residual network plus the state of the current round
+struct Network {
+    int n, s, t;
+    const int64_t* start;
+    const int* head;
+    int* cap;
+    const int64_t* pair;
+    const int* label;      // labels of the round start
+    const int64_t* excess; // excess at the round start
+    int64_t* added;        // excess gained (or given away) during the round
+    int* queued;           // last round in which a vertex joined the next set
+
+    // Discharged this round: the start of the round decides
+    bool active(int w) const { return w != s && w != t && excess[w] > 0 && label[w] < n; }
+};
+
+// What one thread produced in a round
+struct Output {
+    std::vector<int> next; // vertices that may be active in the next round
+    int64_t work = 0;      // relabelling work
+};
+
+void enqueue(const Network& g, int w, int round, Output& out) {
+    if (w != g.s && w != g.t && __atomic_exchange_n(&g.queued[w], round, __ATOMIC_RELAXED) != round)
+        out.next.push_back(w);
+}
+
+// Push v's excess along admissible arcs, relabelling as often as needed;
+// returns v's label for the next round
+int discharge(const Network& g, int v, int round, Output& out) {
+    const int dv = g.label[v];
+    int d = dv;
+    int64_t e = g.excess[v];
+    while (e > 0) {
+        int lowest = g.n;
+        bool skipped = false;
+        for (int64_t a = g.start[v]; a < g.start[v + 1] && e > 0; ++a) {
+            const int c = __atomic_load_n(&g.cap[a], __ATOMIC_RELAXED);
+            if (c == 0) continue;
+            const int w = g.head[a], dw = g.label[w];
+            const bool admissible = d == dw + 1;
+            if (admissible && g.active(w)) {
+                // Both ends are active: only one of them may use the edge this round
+                const bool wins = dv == dw + 1 || dv < dw - 1 || (dv == dw && v < w);
+                if (!wins) { skipped = true; continue; }
+            }
+            if (admissible) {
+                const int delta = static_cast<int>(std::min<int64_t>(c, e));
+                __atomic_fetch_sub(&g.cap[a], delta, __ATOMIC_RELAXED);
+                __atomic_fetch_add(&g.cap[g.pair[a]], delta, __ATOMIC_RELAXED);
+                __atomic_fetch_add(&g.added[w], delta, __ATOMIC_RELAXED);
+                e -= delta;
+                enqueue(g, w, round, out);
+            } else if (dw >= d) {
+                lowest = std::min(lowest, dw + 1);
+            }
+        }
+        if (e == 0 || skipped) break;
+        out.work += (g.start[v + 1] - g.start[v]) + RELABEL_COST;
+        d = lowest;
+        if (d >= g.n) break;
+    }
+    __atomic_fetch_add(&g.added[v], e - g.excess[v], __ATOMIC_RELAXED);
+    if (e > 0 && d < g.n) enqueue(g, v, round, out);
+    return d;
+}
+
+} // namespace
+
+int64_t pushRelabelFlow(const CSRView& G, int s, int t, unsigned threads) {
+    const int n = G.n;
+    if (n == 0 || s < 0 || t < 0 || s >= n || t >= n || s == t) return 0;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Residual network as in EdmondsKarp.cpp; self-loops never carry flow
+    Workspace::Scope scope;
+    int64_t* start = scope.take<int64_t>(n + 1, 0);
+    for (int u = 0; u < n; ++u) {
+        for (const int* p = G.begin(u); p != G.end(u); ++p) {
+            if (*p != u) { ++start[u + 1]; ++start[*p + 1]; }
+        }
+    }
+    for (int u = 0; u < n; ++u) start[u + 1] += start[u];
+
+    const int64_t m = start[n];
+    int* head = scope.take<int>(m);
+    int* cap = scope.take<int>(m);
+    int64_t* pair = scope.take<int64_t>(m);
+    int64_t* fill = scope.take<int64_t>(n);
+    std::copy(start, start + n, fill);
+    for (int u = 0; u < n; ++u) {
+        for (const int* p = G.begin(u); p != G.end(u); ++p) {
+            if (*p == u) continue;
+            int64_t a = fill[u]++, b = fill[*p]++;
+            head[a] = *p; cap[a] = 1; pair[a] = b;
+            head[b] = u;  cap[b] = 0; pair[b] = a;
+        }
+    }
+
+    int* label = scope.take<int>(n);
+    int64_t* excess = scope.take<int64_t>(n, 0);
+    int64_t* added = scope.take<int64_t>(n, 0);
+    int* queued = scope.take<int>(n, 0);
+    int* count = scope.take<int>(n + 1); // vertices per label
+    int* queue = scope.take<int>(n);
+    int maxLabel = 0;                    // highest label below n in use
+
+    // Saturate the arcs out of s
+    for (int64_t a = start[s]; a < start[s + 1]; ++a) {
+        excess[head[a]] += cap[a];
+        cap[pair[a]] += cap[a];
+        cap[a] = 0;
+    }
+
+    // Exact distances to t in the residual network; the rest is lifted to n
+    auto globalRelabel = [&] {
+        std::fill(label, label + n, n);
+        std::fill(count, count + n + 1, 0);
+        label[t] = 0;
+        int qh = 0, qt = 0;
+        queue[qt++] = t;
+        while (qh < qt) {
+            const int v = queue[qh++];
+            ++count[label[v]];
+            maxLabel = label[v];
+            for (int64_t a = start[v]; a < start[v + 1]; ++a) {
+                const int u = head[a];
+                if (u != s && label[u] == n && cap[pair[a]] > 0) {
+                    label[u] = label[v] + 1;
+                    queue[qt++] = u;
+                }
+            }
+        }
+    };
+
+    Network g{n, s, t, start, head, cap, pair, label, excess, added, queued};
+    std::vector<int> active, newLabel;
+    std::vector<Output> outs; // one per thread, kept across rounds
+    auto collectActive = [&] {
+        active.clear();
+        for (int v = 0; v < n; ++v) {
+            if (g.active(v)) active.push_back(v);
+        }
+    };
+
+    const int64_t relabelEvery = 6 * static_cast<int64_t>(n) + m;
+    int64_t work = 0;
+    bool exact = false; // labels are the distances of the last global relabel
+    for (int round = 1;; ++round) {
+        if (active.empty()) {
+            // Labels set in parallel may run ahead of the distances, stranding
+            // excess that could still reach t; only exact labels can end the run
+            if (exact) break;
+            globalRelabel();
+            collectActive();
+            exact = true;
+            work = 0;
+            continue;
+        }
+        exact = false;
+
+        // Discharge every active vertex against the labels of the round start
+        newLabel.resize(active.size());
+        const bool parallel = threads > 1 && active.size() >= PUSH_RELABEL_PARALLEL_MIN_ACTIVE;
+        outs.resize(std::max<size_t>(outs.size(), parallel ? threads : 1));
+        for (Output& out : outs) {
+            out.next.clear();
+            out.work = 0;
+        }
+        if (!parallel) {
+            for (size_t i = 0; i < active.size(); ++i) newLabel[i] = discharge(g, active[i], round, outs[0]);
+        } else {
+            std::atomic<size_t> nextBlock{0};
+            auto worker = [&](unsigned id) {
+                for (size_t b; (b = nextBlock.fetch_add(BLOCK)) < active.size();) {
+                    for (size_t i = b, e = std::min(active.size(), b + BLOCK); i < e; ++i)
+                        newLabel[i] = discharge(g, active[i], round, outs[id]);
+                }
+            };
+            ThreadPool::shared().run(threads, worker);
+        }
+
+        // New labels and excesses take effect together
+        int gap = n;
+        for (size_t i = 0; i < active.size(); ++i) {
+            const int v = active[i], from = label[v], to = newLabel[i];
+            excess[v] += added[v];
+            added[v] = 0;
+            if (to == from) continue;
+            if (--count[from] == 0) gap = std::min(gap, from);
+            label[v] = to;
+            if (to < n) { ++count[to]; maxLabel = std::max(maxLabel, to); }
+        }
+        active.clear();
+        for (Output& out : outs) {
+            work += out.work;
+            for (int v : out.next) {
+                excess[v] += added[v];
+                added[v] = 0;
+                active.push_back(v);
+            }
+        }
+        excess[t] += added[t];
+        added[t] = added[s] = 0;
+
+        if (work > relabelEvery) {
+            globalRelabel(); // may bring lifted vertices back
+            collectActive();
+            exact = true;
+            work = 0;
+            continue;
+        }
+        if (gap < maxLabel && count[gap] == 0) {
+            // Nothing is left at label `gap`: whatever sits above cannot reach t
+            for (int v = 0; v < n; ++v) {
+                if (label[v] > gap && label[v] < n) { --count[label[v]]; label[v] = n; }
+            }
+            maxLabel = gap - 1;
+        }
+        active.erase(std::remove_if(active.begin(), active.end(), [&](int v) { return !g.active(v); }),
+                     active.end());
+    }
+    return excess[t];
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "GraphContext.h"
+
+// Active vertices in a round below which the round runs on one thread
+constexpr size_t PUSH_RELABEL_PARALLEL_MIN_ACTIVE = 1024;
+
+// Arcs from which "auto" prefers push–relabel to Edmonds–Karp
+constexpr int64_t PUSH_RELABEL_MIN_ARCS = 1 << 16;
+
+/**
+ * Max flow with unit capacities by synchronous parallel push–relabel
+ * (after Baumstark, Blelloch, Shun 2015).
+ *
+ * Work proceeds in rounds over the set of active vertices (positive excess,
+ * label below n), FIFO style: every active vertex is discharged against the
+ * labels of the round start, pushes land in a separate excess buffer, and
+ * the new labels and excesses take effect together when the round ends.
+ * When two active neighbours could push to each other, a fixed rule lets
+ * only one of them use the edge, so each residual arc has one writer per
+ * round and the rounds can be split over threads.
+ *
+ *  - global relabel: exact labels by a reverse BFS from t, at the start and
+ *    again whenever relabelling work since the last one exceeds 6n + m
+ *  - gap: when no vertex is left with some label k, the vertices above k
+ *    cannot reach t and are lifted to n at once
+ *
+ * Labels chosen in parallel can run ahead of the true distances, so the run
+ * only ends when a global relabel finds no excess left that can reach t.
+ * Only the first phase runs: the answer is the excess that reached t. The
+ * arcs are read as in EdmondsKarp.h (capacity 1 each, parallel arcs add up).
+ * `threads = 0` uses hardware_concurrency().
+ */
+int64_t pushRelabelFlow(const CSRView& G, int s, int t, unsigned threads = 0);
@@ -0,0 +1,215 @@
+#include "ResultStore.h"
+#include <mutex>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <sys/uio.h>
+
+namespace {
+
+constexpr uint32_t RECORD_MAGIC = 0x52455332; // "RES2": SHA-256 keys; "RES1" logs are dropped
+
+// On-disk record header, followed by `length` payload bytes
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t length;
+    ResultStore::Key key;
+    uint64_t checksum; // FNV-1a of the payload
+};
+
+constexpr uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+} // namespace
+
+ResultStore::Digest::Digest()
+    : state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+      block{} {}
+
+void ResultStore::Digest::compress(const uint8_t* chunk) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i)
+        w[i] = uint32_t(chunk[4 * i]) << 24 | uint32_t(chunk[4 * i + 1]) << 16 |
+               uint32_t(chunk[4 * i + 2]) << 8 | uint32_t(chunk[4 * i + 3]);
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+        uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+ResultStore::Digest& ResultStore::Digest::update(const void* data, size_t n) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    size_t have = bytes % 64;
+    bytes += n;
+    if (have) {
+        size_t k = std::min(n, 64 - have);
+        std::memcpy(block + have, p, k);
+        p += k;
+        n -= k;
+        if (have + k < 64) return *this;
+        compress(block);
+    }
+    for (; n >= 64; p += 64, n -= 64) compress(p);
+    std::memcpy(block, p, n);
+    return *this;
+}
+
+ResultStore::Key ResultStore::Digest::finish() const {
+    Digest d = *this;
+    const uint64_t bits = bytes * 8;
+    const uint8_t pad = 0x80;
+    d.update(&pad, 1);
+    const uint8_t zero[64] = {};
+    d.update(zero, (120 - d.bytes % 64) % 64);
+    uint8_t length[8];
+    for (int i = 0; i < 8; ++i) length[i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+    d.update(length, 8);
+
+    Key out;
+    for (int i = 0; i < 8; ++i)
+        for (int j = 0; j < 4; ++j) out[4 * i + j] = static_cast<uint8_t>(d.state[i] >> (24 - 8 * j));
+    return out;
+}
+
+size_t ResultStore::KeyHash::operator()(const Key& k) const {
+    size_t h;
+    std::memcpy(&h, k.data(), sizeof(h)); // already uniformly distributed
+    return h;
+}
+
+uint64_t ResultStore::hash(const void* data, size_t n, uint64_t seed) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed;
+    for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+ResultStore::ResultStore(const std::string& path, size_t maxBytes) : fd(-1), tail(0), maxBytes(maxBytes) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd >= 0) recover();
+}
+
+ResultStore::~ResultStore() {
+    if (fd >= 0) ::close(fd);
+}
+
+bool ResultStore::ok() const {
+    return fd >= 0;
+}
+
+// Map the whole log and rebuild the index from the record headers
+void ResultStore::recover() {
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || st.st_size == 0) return;
+
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    void* map = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) return;
+    madvise(map, fileSize, MADV_SEQUENTIAL);
+
+    const auto* base = static_cast<const unsigned char*>(map);
+    size_t pos = 0;
+    while (pos + sizeof(RecordHeader) <= fileSize) {
+        RecordHeader h;
+        std::memcpy(&h, base + pos, sizeof(h));
+        size_t payload = pos + sizeof(h);
+        if (h.magic != RECORD_MAGIC || payload + h.length > fileSize) break;
+        if (hash(base + payload, h.length) != h.checksum) break; // torn write
+        index.emplace(h.key, Entry{static_cast<off_t>(payload), h.length});
+        pos = payload + h.length;
+    }
+    munmap(map, fileSize);
+
+    // Drop whatever partial record followed the last good one
+    tail = static_cast<off_t>(pos);
+    if (pos != fileSize && ftruncate(fd, tail) < 0) {
+        tail = static_cast<off_t>(fileSize);
+    }
+}
+
+bool ResultStore::lookup(const Key& key, Entry& out) const {
+    if (fd < 0) return false;
+    std::shared_lock<std::shared_mutex> lk(mtx);
+    auto it = index.find(key);
+    if (it == index.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void ResultStore::put(const Key& key, const std::string& payload) {
+    if (fd < 0) return;
+    std::unique_lock<std::shared_mutex> lk(mtx);
+    if (index.count(key)) return;
+    if (static_cast<size_t>(tail) + sizeof(RecordHeader) + payload.size() > maxBytes) return; // full
+
+    RecordHeader h{RECORD_MAGIC, static_cast<uint32_t>(payload.size()), key,
+                   hash(payload.data(), payload.size())};
+    iovec iov[2] = {
+        {&h, sizeof(h)},
+        {const_cast<char*>(payload.data()), payload.size()}
+    };
+
+    // Write header and payload together at the end of the log
+    const size_t total = sizeof(h) + payload.size();
+    size_t done = 0;
+    while (done < total) {
+        ssize_t w = pwritev(fd, iov, 2, tail + static_cast<off_t>(done));
+        if (w <= 0) return; // leave the index untouched; recover() trims the tail
+        done += static_cast<size_t>(w);
+        // Advance the iovecs past what was written
+        size_t skip = static_cast<size_t>(w);
+        for (auto& v : iov) {
+            size_t s = std::min(skip, v.iov_len);
+            v.iov_base = static_cast<char*>(v.iov_base) + s;
+            v.iov_len -= s;
+            skip -= s;
+        }
+    }
+
+    index.emplace(key, Entry{tail + static_cast<off_t>(sizeof(h)), h.length});
+    tail += static_cast<off_t>(total);
+}
+
+bool ResultStore::sendTo(int sockFd, Entry& e) const {
+    while (e.length) {
+        ssize_t s = ::sendfile(sockFd, fd, &e.offset, e.length);
+        if (s < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        if (s <= 0) return false;
+        e.length -= static_cast<uint32_t>(s);
+    }
+    return true;
+}
+
+size_t ResultStore::size() const {
+    std::shared_lock<std::shared_mutex> lk(mtx);
+    return index.size();
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <shared_mutex>
+#include <sys/types.h>
+
+/**
+ * Disk-backed store of finished algorithm responses.
+ *
+ * The store is a single append-only log file. Every record holds the
+ * request key, the payload length, a checksum and the raw response bytes.
+ * Keys are SHA-256 digests of everything that determines a response (the
+ * graph bytes, the request and the result format version), so neither a
+ * chance nor a forged collision can serve another graph's answer. The log
+ * stops growing at `maxBytes`; later results are simply not stored.
+ * On startup the log is memory-mapped and scanned to rebuild the in-memory
+ * index, so results survive a server restart. A torn record at the tail
+ * (crash mid-write) is detected by its checksum and cut off.
+ *
+ * Cached responses are served with sendfile(), straight from the page cache
+ * to the socket, without copying them into a user-space string.
+ */
+class ResultStore {
+public:
+    using Key = std::array<uint8_t, 32>;
+
+    // Incremental SHA-256, for building keys from data that arrives in pieces
+    class Digest {
+    public:
+        Digest();
+        Digest& update(const void* data, size_t n);
+        Key finish() const; // the digest so far; more can be added afterwards
+
+    private:
+        uint32_t state[8];
+        uint8_t block[64];
+        uint64_t bytes = 0;
+        void compress(const uint8_t* chunk);
+    };
+
+    // Location of one payload inside the log file
+    struct Entry {
+        off_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    explicit ResultStore(const std::string& path, size_t maxBytes);
+    ~ResultStore();
+
+    ResultStore(const ResultStore&) = delete;
+    ResultStore& operator=(const ResultStore&) = delete;
+
+    // False if the log file could not be opened (store is then a no-op)
+    bool ok() const;
+
+    // Find the payload stored under `key`
+    bool lookup(const Key& key, Entry& out) const;
+
+    // Append a payload under `key` (first writer wins, duplicates are ignored;
+    // nothing once the log would pass maxBytes)
+    void put(const Key& key, const std::string& payload);
+
+    // Send a stored payload to a socket with sendfile(). On a non-blocking
+    // socket this stops once the socket is full and advances `e` past what
+    // was sent; false on an error.
+    bool sendTo(int sockFd, Entry& e) const;
+
+    // Number of indexed records
+    size_t size() const;
+
+    // 64-bit FNV-1a, the records' torn-write checksum
+    static uint64_t hash(const void* data, size_t n, uint64_t seed = 1469598103934665603ULL);
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& k) const;
+    };
+
+    int fd;
+    off_t tail; // end of the last complete record
+    size_t maxBytes;
+    std::unordered_map<Key, Entry, KeyHash> index;
+    mutable std::shared_mutex mtx;
+
+    void recover();
+};
@@ -9,9 +9,20 @@
  * Result string includes:
  *  - Number of SCCs
  *  - The vertex list of each component (one line per SCC)
+ *
+ * Option format= picks a more compact result:
+ *  - text  (default) the listing above
+ *  - count only the "SCC count: N" line
+ *  - ids   the component id of every vertex, in vertex order: decimal and
+ *          space-separated on one line, or int32s with encoding=binary
+ *
+ * Option stream sends the encoded result in chunks while it is encoded.
+ * That bounds the size of each piece on the wire, not peak memory: the
+ * whole decomposition is computed and held before the first chunk leaves.
  */
 class SCCAlgorithm : public GraphAlgorithm {
 public:
     std::string name() const override { return "scc"; }
-    std::string run(const Graph& g) override;
+    using GraphAlgorithm::run;
+    AlgorithmResult compute(GraphContext& ctx, const Options& opts) override;
 };
@@ -0,0 +1,34 @@
+#include "Scheduler.h"
+#include <algorithm>
+#include <cstdio>
+
+void LatencyTracker::record(std::chrono::steady_clock::duration d) {
+    const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    std::lock_guard<std::mutex> lk(m);
+    if (window.size() < LATENCY_WINDOW) window.push_back(ns);
+    else window[next] = ns;
+    next = (next + 1) % LATENCY_WINDOW;
+    ++total;
+}
+
+std::string LatencyTracker::summary() {
+    std::vector<int64_t> s;
+    uint64_t n;
+    {
+        std::lock_guard<std::mutex> lk(m);
+        s = window;
+        n = total;
+    }
+    if (s.empty()) return "0 tasks";
+
+    // Nearest-rank percentile of the sorted window
+    std::sort(s.begin(), s.end());
+    auto ms = [&](double p) {
+        size_t rank = static_cast<size_t>(p * s.size() + 0.999999);
+        return s[std::clamp<size_t>(rank, 1, s.size()) - 1] / 1e6;
+    };
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "%llu tasks, p50 %.3f ms, p99 %.3f ms, max %.3f ms",
+                  static_cast<unsigned long long>(n), ms(0.50), ms(0.99), s.back() / 1e6);
+    return buf;
+}
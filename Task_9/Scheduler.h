@@ -0,0 +1,213 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+// Estimated cost (arc visits, see AlgorithmFactory::estimateCost) up to which a task is short
+constexpr double SHORT_LANE_MAX_COST = 1 << 20;
+
+// Virtual-deadline slack per tenfold of estimated cost, and its bound
+constexpr double AGING_NS_PER_DECADE = 10e6;
+constexpr double AGING_MAX_SLACK_NS = 2e9;
+
+// Latency samples kept per lane for the percentiles
+constexpr size_t LATENCY_WINDOW = 4096;
+
+// Micro-batches: most tasks, and most estimated cost, one worker takes per wake-up
+constexpr size_t MICRO_BATCH = 64;
+constexpr double MICRO_BATCH_COST = 1 << 16;
+
+/**
+ * Cost-aware scheduling for the compute stage.
+ *
+ * Every task is given an estimated cost before it is queued. Cheap tasks
+ * go to the short lane and the rest to the long lane. Each lane has its own
+ * workers, so an mst or scc request never waits behind a long flow or
+ * Hamiltonian search.
+ *
+ * Within a connection's share of a lane (see FairQueue) the task with the
+ * earliest virtual deadline runs first: its arrival time plus a slack that
+ * grows with the log of its cost, AGING_NS_PER_DECADE per tenfold, up to
+ * AGING_MAX_SLACK_NS. Among tasks that arrive together this is
+ * shortest-expected-job-first. Estimates span 1 to 1e300, so the slack is
+ * log-scaled and bounded: a task's deadline never moves, and once it has
+ * waited two seconds it outranks every newcomer, whatever its estimate.
+ */
+enum Lane { SHORT_LANE, LONG_LANE, LANES };
+
+inline Lane laneFor(double cost) { return cost <= SHORT_LANE_MAX_COST ? SHORT_LANE : LONG_LANE; }
+
+inline const char* laneName(Lane lane) { return lane == SHORT_LANE ? "short" : "long"; }
+
+// Cost a connection may spend per deficit round-robin turn of a compute lane
+constexpr double FAIR_QUANTUM = SHORT_LANE_MAX_COST;
+
+// Most a single task is charged, in quanta: estimates run up to 1e300,
+// and a task must not park its connection for that many turns
+constexpr double FAIR_MAX_QUANTA = 64;
+
+/**
+ * A blocking queue shared fairly between flows (client connections).
+ *
+ * Every flow has its own sub-queue, ordered by virtual deadline as above.
+ * Flows with work take turns in deficit round-robin: a turn adds the
+ * queue's quantum (FAIR_QUANTUM unless given) to the flow's deficit, and the
+ * flow sends tasks while the first one's cost fits. A client that floods
+ * the server only ever gets its share of each turn, so others wait at most
+ * one round behind it. Items that all cost the quantum make this plain
+ * round-robin, one item per turn.
+ *
+ * popBatch() hands a worker a run of cheap tasks (graphs of a few dozen
+ * vertices) for one lock and one wake-up; their per-task queueing cost
+ * otherwise outweighs the algorithm itself.
+ */
+template<typename T>
+class FairQueue {
+    struct Item {
+        int64_t deadline; // ns on the steady clock
+        uint64_t seq;
+        double charge;    // DRR packet size
+        T task;
+    };
+    struct Later {
+        bool operator()(const Item& a, const Item& b) const {
+            return a.deadline != b.deadline ? a.deadline > b.deadline : a.seq > b.seq;
+        }
+    };
+    struct Flow {
+        std::priority_queue<Item, std::vector<Item>, Later> tasks;
+        double deficit = 0;
+    };
+
+    const double quantum;      // deficit added per turn
+    std::map<int, Flow> flows; // only flows with queued tasks
+    std::deque<int> active;    // turn order; the front flow is being served
+    bool turnStarted = false;  // the front flow already has this turn's quantum
+    uint64_t seq = 0;
+    std::mutex m;
+    std::condition_variable cv;
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Caller holds the lock
+    void enqueue(T v, int flow, double cost, int64_t now) {
+        const int64_t slack = static_cast<int64_t>(
+            std::min(AGING_NS_PER_DECADE * std::log10(1 + std::max(cost, 0.0)), AGING_MAX_SLACK_NS));
+        const double charge = std::min(cost, quantum * FAIR_MAX_QUANTA);
+        Flow& f = flows[flow];
+        if (f.tasks.empty()) active.push_back(flow);
+        f.tasks.push(Item{now + slack, seq++, charge, std::move(v)});
+    }
+
+    // Run the round until the front flow's first task fits its deficit and
+    // return that flow. Caller holds the lock; some flow has work.
+    typename std::map<int, Flow>::iterator nextFlow() {
+        for (;;) {
+            auto it = flows.find(active.front());
+            Flow& f = it->second;
+            if (!turnStarted) { f.deficit += quantum; turnStarted = true; }
+            if (f.tasks.top().charge <= f.deficit) return it;
+            // Turn over: to the back of the round, the deficit carries over
+            active.push_back(active.front());
+            active.pop_front();
+            turnStarted = false;
+        }
+    }
+
+    // Dequeue the first task of the flow nextFlow() returned
+    T take(typename std::map<int, Flow>::iterator it) {
+        Flow& f = it->second;
+        f.deficit -= f.tasks.top().charge;
+        T out = std::move(const_cast<Item&>(f.tasks.top()).task); // popped right away
+        f.tasks.pop();
+        if (f.tasks.empty()) { // an idle flow keeps no credit
+            flows.erase(it);
+            active.pop_front();
+            turnStarted = false;
+        }
+        return out;
+    }
+
+public:
+    explicit FairQueue(double q = FAIR_QUANTUM) : quantum(q) {}
+
+    void push(T v, int flow, double cost) {
+        const int64_t now = nowNs();
+        {
+            std::lock_guard<std::mutex> lk(m);
+            enqueue(std::move(v), flow, cost, now);
+        }
+        cv.notify_one();
+    }
+
+    // Queue a batch with one lock and one wake-up; flowOf(v) names each task's flow
+    template<typename FlowOf>
+    void pushAll(std::vector<T>& vs, FlowOf flowOf, double cost) {
+        if (vs.empty()) return;
+        const int64_t now = nowNs();
+        {
+            std::lock_guard<std::mutex> lk(m);
+            for (T& v : vs) {
+                const int flow = flowOf(v);
+                enqueue(std::move(v), flow, cost, now);
+            }
+        }
+        vs.clear();
+        cv.notify_one();
+    }
+
+    bool pop(T& out, const std::atomic<bool>& down) {
+        std::unique_lock<std::mutex> lk(m);
+        cv.wait(lk, [&]{ return !active.empty() || down; });
+        if (active.empty()) return false;
+        out = take(nextFlow());
+        return true;
+    }
+
+    // Like pop(), then keep taking tasks in the same fair order while the
+    // batch stays within `maxCount` tasks and `maxCost`. The first task is
+    // always taken, whatever its cost.
+    bool popBatch(std::vector<T>& out, size_t maxCount, double maxCost, const std::atomic<bool>& down) {
+        out.clear();
+        std::unique_lock<std::mutex> lk(m);
+        cv.wait(lk, [&]{ return !active.empty() || down; });
+        if (active.empty()) return false;
+        double cost = 0;
+        do {
+            auto it = nextFlow();
+            cost += it->second.tasks.top().charge;
+            if (!out.empty() && cost > maxCost) break;
+            out.push_back(take(it));
+        } while (out.size() < maxCount && !active.empty());
+        // Leftovers are for the other workers
+        if (!active.empty()) cv.notify_one();
+        return true;
+    }
+};
+
+// Recent latencies of one lane
+class LatencyTracker {
+public:
+    void record(std::chrono::steady_clock::duration d);
+
+    // "<n> tasks, p50 <ms>, p99 <ms>, max <ms>" over the last LATENCY_WINDOW tasks
+    std::string summary();
+
+private:
+    std::mutex m;
+    std::vector<int64_t> window; // ns, a ring once full
+    size_t next = 0;
+    uint64_t total = 0;
+};
@@ -1,173 +1,547 @@
 #include <iostream>
 #include <thread>
 #include <vector>
-#include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 #include <map>
+#include <set>
 #include <string>
 #include <cstring>
 #include <netinet/in.h>
 #include <unistd.h>
+#include <getopt.h>
+#include <climits>
+#include <cstdlib>
+#include <sys/stat.h>
 #include <cstdint>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <stdexcept>
+#include <csignal>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
 
 #include "Graph.h"
+#include "GraphContext.h"
+#include "Arena.h"
+#include "GraphFile.h"
+#include "EdgeIngest.h"
 #include "AlgorithmFactory.h"
+#include "ResultStore.h"
+#include "Scheduler.h"
+#include "ClientWriter.h"
+#include "Connection.h"
 
 constexpr int   PORT = 12345;
-constexpr size_t BUF = 1 << 16;
-
-// Helper functions for I/O
-static bool readAll(int fd, void* buf, size_t n) {
-    auto* p = static_cast<uint8_t*>(buf);
-    while (n) {
-        ssize_t r = ::read(fd, p, n);
-        if (r <= 0) return false;
-        p += r; 
-        n -= r;
+constexpr size_t BUF = 1 << 16; // socket read buffer; bigger result bodies skip the write coalescing
+constexpr char  STORE_PATH[] = "results.store"; // persistent result log
+constexpr size_t STORE_MAX_BYTES = size_t(1) << 30; // the log stops growing here
+constexpr int   PARALLEL_BUILD_EDGES = 1 << 20; // scatter big uploads on all cores
+constexpr size_t INGEST_CHUNK_EDGES = 1 << 16; // edges per read while folding connectivity
+constexpr int   GRAPH_BY_PATH = -1; // V value meaning "E = length of a .graph path that follows"
+constexpr char  GRAPH_DIR[] = "graphs"; // the only place GRAPH_BY_PATH requests may read (-d to change)
+constexpr int32_t MAX_GRAPH_PATH = 255; // length of a path relative to the graph directory
+constexpr size_t MAX_MAPPED_GRAPHS = 64; // validated mappings kept for reuse
+constexpr int   MAX_UPLOAD_VERTICES = 1 << 24; // V is allocated before any edge arrives
+constexpr int   MAX_UPLOAD_EDGES = 1 << 27; // 1 GiB of edges held while the request runs
+constexpr int32_t MAX_REQUEST_BYTES = 4096; // length of "<algo> key=value ..."
+constexpr int32_t STREAMED_RESULT = -1; // length prefix of a streamed result: [len][bytes]... then [0]
+constexpr int   LANE_WORKERS[LANES] = {2, 2}; // compute threads of the short and long lanes
+
+// Algorithm ids of the response frames: [request id][algorithm id][result]
+constexpr const char* ALGORITHMS[] = {"mst", "scc", "maxflow", "hamilton"};
+constexpr int32_t NO_ALGORITHM = -1; // the request named none of them
+
+static int32_t algorithmId(const std::string& name) {
+    int32_t id = 0;
+    for (const char* a : ALGORITHMS) {
+        if (name == a) return id;
+        ++id;
     }
-    return true;
-}
-static bool writeAll(int fd, const void* buf, size_t n) {
-    const auto* p = static_cast<const uint8_t*>(buf);
-    while (n) {
-        ssize_t w = ::write(fd, p, n);
-        if (w <= 0) return false;
-        p += w; 
-        n -= w;
-    }
-    return true;
+    return NO_ALGORITHM;
 }
 
-// Thread-safe queue data structure helper
-template<typename T>
-class ThreadQueue {
-    std::queue<T> q;
-    std::mutex m;
-    std::condition_variable cv;
+// Buffered reads from a client socket: pipelined requests of small graphs
+// arrive many per read() instead of six reads each. The socket is
+// non-blocking (for the ClientWriter), so an empty one is waited on with poll().
+class SocketReader {
+    int fd;
+    std::vector<uint8_t> buf;
+    size_t at = 0, end = 0;
 public:
-    void push(T v) {
-        { std::lock_guard<std::mutex> lk(m); q.push(std::move(v)); }
-        cv.notify_one();
-    }
-    bool pop(T& out, const std::atomic<bool>& down) {
-        std::unique_lock<std::mutex> lk(m);
-        cv.wait(lk, [&]{ return !q.empty() || down; });
-        if (q.empty()) return false;
-        out = std::move(q.front());
-        q.pop();
+    explicit SocketReader(int f) : fd(f), buf(BUF) {}
+
+    bool readAll(void* out, size_t n) {
+        auto* p = static_cast<uint8_t*>(out);
+        while (n) {
+            if (at == end) {
+                // Large payloads go straight to the caller
+                uint8_t* dst = n >= buf.size() ? p : buf.data();
+                ssize_t r = ::read(fd, dst, n >= buf.size() ? n : buf.size());
+                if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                    pollfd p{fd, POLLIN, 0};
+                    if (poll(&p, 1, -1) < 0 && errno != EINTR) return false;
+                    continue;
+                }
+                if (r <= 0) return false;
+                if (dst == p) { p += r; n -= r; continue; }
+                at = 0;
+                end = r;
+            }
+            size_t k = std::min(n, end - at);
+            std::memcpy(p, buf.data() + at, k);
+            at += k;
+            p += k;
+            n -= k;
+        }
         return true;
     }
 };
 
 // Task Struct represents a unit of work passed between pipeline stages
 struct Task {
-    int clientFd; // Client socket
+    std::shared_ptr<Connection> conn; // The client; nullptr is the workers' shutdown sentinel
+    int32_t requestId; // Chosen by the client, echoed in every response to the request
     std::string algorithm; // Algorithm name
-    Graph graph; // Graph to run algorithm on
+    GraphAlgorithm::Options options; // Request options ("format", "stream", ...)
+    std::shared_ptr<GraphContext> ctx; // Graph plus analysis shared by all its tasks
+    std::optional<ResultStore::Key> key; // Result store key for (graph, algorithm, options); none: do not store
+    std::chrono::steady_clock::time_point queued; // When the request was queued, for the lane latencies
 
     // default sentinel → makes the type default-constructible
-    Task() : clientFd(-1), algorithm(), graph(0) {}
-    Task(int fd, std::string alg, const Graph& g)
-        : clientFd(fd), algorithm(std::move(alg)), graph(g) {}
+    Task() : conn(), requestId(0), algorithm(), options(), ctx(), key(), queued() {}
+    Task(std::shared_ptr<Connection> c0, int32_t id, std::string alg, GraphAlgorithm::Options opts, std::shared_ptr<GraphContext> c,
+         std::optional<ResultStore::Key> k)
+        : conn(std::move(c0)), requestId(id), algorithm(std::move(alg)), options(std::move(opts)), ctx(std::move(c)), key(k),
+          queued(std::chrono::steady_clock::now()) {}
+};
+
+// Response Struct represents a finished result waiting to be sent
+struct Response {
+    std::shared_ptr<Connection> conn; // The client; nullptr is the responder's shutdown sentinel
+    int32_t requestId; // Frame header: the request this answers...
+    int32_t algorithm; // ...and which of its algorithms (ALGORITHMS index)
+    AlgorithmResult result; // Freshly computed result, encoded by the response stage
+    std::shared_ptr<GraphContext> ctx; // Keeps whatever `result` points into alive
+    Encoding encoding; // Text or binary, from the request's "encoding" option
+    bool streamed; // Send in chunks while encoding (request option "stream")
+    std::optional<ResultStore::Key> key; // Result store key (none: do not store)
+    bool cached; // true → send `entry` from the result store instead of `result`
+    ResultStore::Entry entry;
+
+    Response() : conn(), requestId(0), algorithm(NO_ALGORITHM), result(), ctx(), encoding(Encoding::Text), streamed(false), key(), cached(false), entry() {}
+    Response(std::shared_ptr<Connection> c, int32_t id, int32_t alg, AlgorithmResult r, Encoding enc)
+        : conn(std::move(c)), requestId(id), algorithm(alg), result(std::move(r)), ctx(), encoding(enc), streamed(false), key(), cached(false), entry() {}
+    Response(std::shared_ptr<Connection> c, int32_t id, int32_t alg, const ResultStore::Entry& e)
+        : conn(std::move(c)), requestId(id), algorithm(alg), result(), ctx(), encoding(Encoding::Text), streamed(false), key(), cached(true), entry(e) {}
 };
 
 std::atomic<bool> shuttingDown{false};
 
-// One queue for each algorithm worker
-ThreadQueue<Task> algoQ[4]; // 0 mst 1 scc 2 maxflow 3 hamilton
-ThreadQueue<std::pair<int,std::string>> resultQ; // Shared result queue (for response stage)
+// Compute tasks by estimated cost, shared fairly between connections (Scheduler.h)
+FairQueue<Task> laneQ[LANES];
+LatencyTracker laneLatency[LANES]; // queued → computed
+FairQueue<Response> resultQ(1); // Shared result queue (for response stage): responses cost 1, one per turn
+ClientWriter clientWriter; // Per-client outbound buffers, so no client's socket stalls the others
+
+// Results survive restarts; repeated (graph, algorithm) requests skip the compute stage
+ResultStore resultStore(STORE_PATH, STORE_MAX_BYTES);
+
+// Key of one (graph, algorithm, options) triple in the result store.
+// "stream" only changes how the result is delivered, so it is left out.
+static ResultStore::Key requestKey(const ResultStore::Digest& graph, const std::string& algo,
+                                   const GraphAlgorithm::Options& opts) {
+    std::string canonical = "v" + std::to_string(RESULT_FORMAT_VERSION) + " " + algo;
+    for (const auto& [k, v] : opts)
+        if (k != "stream") canonical += " " + k + "=" + v;
+    ResultStore::Digest d = graph;
+    return d.update(canonical.data(), canonical.size()).finish();
+}
 
 ////////////////// Worker Threads //////////////////
 
-// Algorithm computation stage
-void algorithmWorker(int idx, const std::string& name)
+// "encoding=binary" selects the compact result records
+static Encoding encodingOf(const GraphAlgorithm::Options& opts) {
+    auto it = opts.find("encoding");
+    return it != opts.end() && it->second == "binary" ? Encoding::Binary : Encoding::Text;
+}
+
+// Algorithm computation stage: one of the workers of a lane
+void algorithmWorker(Lane lane)
 {
-    Task t;
-    while (algoQ[idx].pop(t, shuttingDown)) 
+    // Long-lived instances, one per algorithm; temporaries come from this thread's Workspace
+    std::map<std::string, std::unique_ptr<GraphAlgorithm>> algs;
+    std::vector<Task> batch; // cheap tasks come in runs, see FairQueue::popBatch
+    std::vector<Response> done;
+    bool running = true;
+    while (running && laneQ[lane].popBatch(batch, MICRO_BATCH, MICRO_BATCH_COST, shuttingDown)) 
     {
-        if (t.clientFd == -1) break; // sentinel
-        auto alg = AlgorithmFactory::create(name);
-        std::string res = alg->run(t.graph); // Run algorithm
-        resultQ.push({t.clientFd, std::move(res)}); // Push result to responder
+        for (Task& t : batch) {
+            if (!t.conn) { running = false; break; } // sentinel
+            if (t.conn->closed) continue; // nobody left to answer
+            auto& alg = algs[t.algorithm];
+            if (!alg) alg = AlgorithmFactory::create(t.algorithm);
+            // Run the variant the factory picks for this graph; formatting is left to the response stage
+            Response r(std::move(t.conn), t.requestId, algorithmId(t.algorithm),
+                       AlgorithmFactory::dispatch(*alg, *t.ctx, t.options), encodingOf(t.options));
+            laneLatency[lane].record(std::chrono::steady_clock::now() - t.queued);
+            r.ctx = std::move(t.ctx);
+            r.streamed = t.options.count("stream") > 0;
+            r.key = t.key;
+            done.push_back(std::move(r));
+        }
+        batch.clear();
+        // Push the batch's results to the responder in one go
+        resultQ.pushAll(done, [](const Response& r) { return r.conn->fd; }, 1);
     }
 }
 
-// Sends responses back to client
+// Encodes results and hands them to the client writer
 void responseWorker()
 {
-    std::pair<int,std::string> job;
-    while (resultQ.pop(job, shuttingDown)) // Wait for result
+    auto appendLength = [](std::string& frames, int32_t n) {
+        int32_t len = htonl(n);
+        frames.append(reinterpret_cast<const char*>(&len), 4);
+    };
+
+    // A batch's frames for one client are queued together
+    std::map<std::shared_ptr<Connection>, std::string> out;
+    auto flush = [&](const std::shared_ptr<Connection>& conn) {
+        auto it = out.find(conn);
+        if (it == out.end()) return;
+        clientWriter.append(conn, std::move(it->second));
+        out.erase(it);
+    };
+
+    std::vector<Response> batch;
+    bool running = true;
+    while (running && resultQ.popBatch(batch, MICRO_BATCH, MICRO_BATCH_COST, shuttingDown)) // Wait for results
     {
-        if (job.first == -1) break; // sentinel
-        int32_t len = htonl(job.second.size());
-        if (!writeAll(job.first, &len, 4) ||
-            !writeAll(job.first, job.second.data(), job.second.size()))
-            close(job.first); // Close socket on failure
+        for (Response& job : batch) {
+            if (!job.conn) { running = false; break; } // sentinel
+            if (job.conn->closed) continue;
+            const std::shared_ptr<Connection>& conn = job.conn;
+
+            // Responses to pipelined requests leave in completion order; the header says which is which
+            std::string& frames = out[conn];
+            appendLength(frames, job.requestId);
+            appendLength(frames, job.algorithm);
+            if (job.cached) {
+                // Cached results go page cache → socket without a user-space copy
+                appendLength(frames, job.entry.length);
+                flush(conn);
+                clientWriter.appendStored(conn, resultStore, job.entry);
+            } else if (job.streamed) {
+                // Encoded pieces go out as chunks while the rest is encoded;
+                // the result is never whole here, so it is not stored either
+                appendLength(frames, STREAMED_RESULT);
+                encodeResult(job.result, job.encoding, [&](const char* p, size_t n) {
+                    std::string& chunk = out[conn];
+                    appendLength(chunk, n);
+                    chunk.append(p, n);
+                    if (chunk.size() >= BUF) flush(conn);
+                });
+                appendLength(out[conn], 0);
+            } else {
+                std::string body = encodeResult(job.result, job.encoding);
+                if (job.key) resultStore.put(*job.key, body); // Persist for later identical requests
+                appendLength(frames, body.size());
+                if (body.size() < BUF) frames += body;
+                else { flush(conn); clientWriter.append(conn, std::move(body)); }
+            }
+        }
+        for (auto& [conn, frames] : out) clientWriter.append(conn, std::move(frames));
+        out.clear();
+        batch.clear(); // Drop our share of the graphs before blocking on the queue
     }
+    clientWriter.stop();
+}
+
+// An uploaded edge list, folded into an EdgeIngest while it arrived; the
+// Graph is only built once the request shows it is needed
+struct Upload {
+    int V = 0;
+    std::shared_ptr<RequestArena> arena;
+    std::optional<EdgeIngest> ingest;
+    std::vector<Edge> edges;
+};
+
+// Receive an uploaded edge list. false if the client left; `error` is set
+// if the vertex or edge count is refused (the edges are still consumed).
+static bool receiveEdges(SocketReader& in, int32_t v_net, int32_t e_net, ResultStore::Digest& graph,
+                         Upload& up, std::string& error)
+{
+    const int V = ntohl(v_net), E = ntohl(e_net);
+    const size_t edgeCount = static_cast<size_t>(E);
+
+    // Everything below is sized from V and E, so refuse counts the server
+    // cannot hold; the edges are still read to stay in step with the client
+    if (V < 0 || V > MAX_UPLOAD_VERTICES || E > MAX_UPLOAD_EDGES) {
+        Edge part[1024];
+        for (size_t done = 0; done < edgeCount;) {
+            size_t chunk = std::min(edgeCount - done, std::size(part));
+            if (!in.readAll(part, chunk * sizeof(Edge))) return false;
+            done += chunk;
+        }
+        error = E > MAX_UPLOAD_EDGES
+            ? "Error: edge count must be at most " + std::to_string(MAX_UPLOAD_EDGES) + "\n"
+            : "Error: vertex count must be between 0 and " + std::to_string(MAX_UPLOAD_VERTICES) + "\n";
+        return true;
+    }
+
+    // The graph and everything derived from it live in one request arena.
+    // E is only a claim until the edges arrive: the arena grows past one chunk.
+    up.V = V;
+    up.arena = std::make_shared<RequestArena>(
+        RequestArena::estimate(V, static_cast<int>(std::min(edgeCount, INGEST_CHUNK_EDGES))));
+    up.ingest.emplace(V, up.arena.get());
+
+    // Hash the request bytes as sent (network order)
+    graph.update(&v_net, 4).update(&e_net, 4);
+
+    // Receive the edge list in chunks, folding connectivity and degrees in
+    // while the next chunk is still on the wire. The buffer grows with the
+    // data actually received, not with the announced count.
+    up.edges.reserve(std::min(edgeCount, INGEST_CHUNK_EDGES));
+    for (size_t done = 0; done < edgeCount;) {
+        size_t chunk = std::min(edgeCount - done, INGEST_CHUNK_EDGES);
+        up.edges.resize(done + chunk);
+        Edge* part = up.edges.data() + done;
+        if (!in.readAll(part, chunk * sizeof(Edge))) return false;
+        graph.update(part, chunk * sizeof(Edge));
+        for (size_t i = 0; i < chunk; ++i) {
+            part[i].u = ntohl(part[i].u);
+            part[i].v = ntohl(part[i].v);
+        }
+        up.ingest->add(part, chunk);
+        done += chunk;
+    }
+    return true;
+}
+
+// mst is decided by connectivity alone, which the ingest already knows
+static MSTResult mstFromIngest(Upload& up)
+{
+    MSTResult r;
+    r.vertices = up.V;
+    if (r.vertices == 0) return r;
+    r.connected = up.ingest->componentCount() == 1;
+    if (r.connected) r.weight = r.vertices - 1;
+    return r;
+}
+
+// Build the uploaded graph; nullptr with `error` set for bad endpoints and self-loops.
+// One context per graph: an "all" request computes shared artifacts once.
+static std::shared_ptr<GraphContext> buildGraph(Upload& up, std::string& error)
+{
+    auto g = std::make_shared<Graph>(up.V, up.arena.get());
+    unsigned threads = up.edges.size() >= PARALLEL_BUILD_EDGES ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+    try {
+        g->addEdges(up.edges.data(), up.edges.size(), threads);
+    } catch (const std::logic_error& ex) { // out_of_range, invalid_argument
+        error = std::string("Error: ") + ex.what() + "\n";
+        return nullptr;
+    }
+    std::vector<Edge>().swap(up.edges);
+    auto ctx = std::make_shared<GraphContext>(std::move(g), std::move(up.arena));
+    ctx->seed(up.ingest->components(), up.ingest->degrees()); // no second pass for components or degrees
+    return ctx;
+}
+
+// Resolved graph directory; empty if it does not exist (file requests are then refused)
+std::string graphDir;
+
+// Validated mappings by resolved path, reused until the file changes
+std::mutex mappedLock;
+std::map<std::string, std::shared_ptr<const MappedGraph>> mappedGraphs;
+
+// Map a .graph file from the graph directory; nullptr (and `error`) if it
+// cannot be used. `name` comes from the client: it must stay inside the
+// directory, and every failure gets the same answer, which does not tell
+// whether a file exists.
+static std::shared_ptr<GraphContext> openGraphFile(const std::string& name, ResultStore::Digest& graph, std::string& error)
+{
+    error = "Error: graph file unavailable\n";
+    if (graphDir.empty() || name.empty() || name[0] == '/') return nullptr;
+    for (size_t at = 0; at <= name.size();) {
+        size_t end = std::min(name.find('/', at), name.size());
+        if (name.compare(at, end - at, "..") == 0) return nullptr;
+        at = end + 1;
+    }
+    // Symbolic links must not lead out of the directory either
+    char resolved[PATH_MAX];
+    if (!realpath((graphDir + "/" + name).c_str(), resolved)) return nullptr;
+    const std::string path = resolved;
+    if (path.compare(0, graphDir.size() + 1, graphDir + "/") != 0) return nullptr;
+    struct stat st{};
+    if (stat(path.c_str(), &st) < 0) return nullptr;
+    const int64_t mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+
+    // Opening validates every offset and target, so keep the mapping
+    std::shared_ptr<const MappedGraph> file;
+    {
+        std::lock_guard<std::mutex> lk(mappedLock);
+        auto it = mappedGraphs.find(path);
+        if (it != mappedGraphs.end() && it->second->modified() == mtime &&
+            it->second->size() == static_cast<size_t>(st.st_size)) file = it->second;
+    }
+    if (!file) {
+        try {
+            file = std::make_shared<MappedGraph>(path);
+        } catch (const std::exception& ex) {
+            std::cout << "[Server] " << ex.what() << '\n';
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lk(mappedLock);
+        if (mappedGraphs.size() >= MAX_MAPPED_GRAPHS) mappedGraphs.erase(mappedGraphs.begin());
+        mappedGraphs[path] = file;
+    }
+    error.clear();
+
+    // Key on the path and the file's identity, so a rewritten file is recomputed.
+    // Files are the server's own: hashing every byte would undo the cheap open.
+    int64_t stamp[2] = {file->modified(), static_cast<int64_t>(file->size())};
+    graph.update(path.data(), path.size()).update(stamp, sizeof(stamp));
+    return std::make_shared<GraphContext>(std::move(file));
 }
 
 // Initial Receiver Thread: First stage of pipeline: accepts and parses client requests
+// The socket is closed once this and every queued task and response for it are done
 void connectionHandler(int cfd)
 {
+    auto conn = std::make_shared<Connection>(cfd);
+    SocketReader in(cfd);
     while (!shuttingDown) {
 
-        // Read number of vertices and edges
-        int32_t v_net, e_net;
-        if (!readAll(cfd, &v_net, 4) || !readAll(cfd, &e_net, 4)) break;
-        int V = ntohl(v_net), E = ntohl(e_net);
-
-        // Build graph from edge list
-        Graph g(V);
-        for (int i = 0; i < E; ++i) {
-            int32_t u_net, v2_net;
-            if (!readAll(cfd, &u_net, 4) || !readAll(cfd, &v2_net, 4)) { close(cfd); return; }
-            g.addEdge(ntohl(u_net), ntohl(v2_net));
+        // Read the request id, then number of vertices and edges
+        int32_t id_net, v_net, e_net;
+        if (!in.readAll(&id_net, 4) || !in.readAll(&v_net, 4) || !in.readAll(&e_net, 4)) break;
+        const int32_t requestId = ntohl(id_net);
+        if (static_cast<int32_t>(ntohl(e_net)) < 0) break; // no way to find the next request
+
+        std::shared_ptr<GraphContext> ctx;
+        ResultStore::Digest graph;
+        std::string loadError;
+        Upload up;
+        if (static_cast<int32_t>(ntohl(v_net)) == GRAPH_BY_PATH)
+        {
+            // Graph by reference: the edge count field carries a path length
+            int32_t len = ntohl(e_net);
+            if (len > MAX_GRAPH_PATH) break;
+            std::string path(len, '\0');
+            if (!in.readAll(path.data(), path.size())) break;
+            ctx = openGraphFile(path, graph, loadError);
+        }
+        else
+        {
+            if (!receiveEdges(in, v_net, e_net, graph, up, loadError)) return;
         }
 
-        // Read algorithm name (length-prefixed)
+        // Read algorithm name (length-prefixed), optionally followed by options
         int32_t len_net; 
-        if (!readAll(cfd, &len_net, 4)) break;
-        std::string algo(ntohl(len_net), '\0');
-        if (!readAll(cfd, algo.data(), algo.size())) break;
+        if (!in.readAll(&len_net, 4)) break;
+        const int32_t requestBytes = ntohl(len_net);
+        if (requestBytes < 0 || requestBytes > MAX_REQUEST_BYTES) break;
+        std::string request(requestBytes, '\0');
+        if (!in.readAll(request.data(), request.size())) break;
+        GraphAlgorithm::Options opts;
+        std::string algo = AlgorithmFactory::parse(request, opts);
+
+        if (up.ingest) {
+            // A valid upload asking for mst alone is answered the moment its
+            // last edge has landed: no graph is built and no lane is queued
+            if (algo == "mst" && up.ingest->valid() && !opts.count("explain") && !opts.count("variant")) {
+                Response r(conn, requestId, algorithmId(algo), mstFromIngest(up), encodingOf(opts));
+                r.streamed = opts.count("stream") > 0;
+                resultQ.push(std::move(r), cfd, 1);
+                continue;
+            }
+            ctx = buildGraph(up, loadError);
+        }
+
+        // Answer from the result store when possible, otherwise queue for
+        // compute in the lane its estimated cost calls for
+        auto dispatch = [&](const std::string& name) {
+            const int32_t id = algorithmId(name);
+            if (!ctx) { resultQ.push({conn, requestId, id, ErrorResult{loadError}, encodingOf(opts)}, cfd, 1); return; }
+            // explain plans depend on this machine's cores, not only on the request
+            std::optional<ResultStore::Key> key;
+            if (!opts.count("explain")) {
+                key = requestKey(graph, name, opts);
+                ResultStore::Entry e;
+                if (resultStore.lookup(*key, e)) { resultQ.push({conn, requestId, id, e}, cfd, 1); return; }
+            }
+            const double cost = AlgorithmFactory::estimateCost(name, *ctx, opts);
+            laneQ[laneFor(cost)].push({conn, requestId, name, opts, ctx, key}, cfd, cost);
+        };
 
-        // Handle "all" command: send same graph to all algorithm workers
+        // Handle "all" command: send same graph to all algorithms
         if (algo == "all") 
         {
-            for (const auto& [i,n] : std::map<int,std::string>{{0,"mst"},{1,"scc"},{2,"maxflow"},{3,"hamilton"}})
-                algoQ[i].push({cfd, n, g});
+            for (const char* name : ALGORITHMS) dispatch(name);
         } 
-        else // Map algorithm name to queue index
+        else if (algorithmId(algo) != NO_ALGORITHM)
         {
-            int i = (algo=="mst")?0:(algo=="scc")?1:(algo=="maxflow")?2:(algo=="hamilton")?3:-1;
-            if (i >= 0) algoQ[i].push({cfd, algo, g});
+            dispatch(algo);
+        }
+        else // A pipelining client counts on one response per request
+        {
+            resultQ.push({conn, requestId, NO_ALGORITHM, ErrorResult{"Error: Unknown algorithm: " + algo + "\n"},
+                          encodingOf(opts)}, cfd, 1);
         }
     }
-    close(cfd);
 }
 
-// ─────────────── stdin “quit” watcher ───────────────
+// Per-lane latency percentiles
+static void printLaneStats()
+{
+    for (int l = 0; l < LANES; ++l)
+        std::cout << "[Server] " << laneName(Lane(l)) << " lane: " << laneLatency[l].summary() << '\n';
+}
+
+// ─────────────── stdin “quit” / “stats” watcher ───────────────
 void stdinWatcher(int listenFd)
 {
     std::string line;
     while (std::getline(std::cin, line)) {
+        if (line == "stats") printLaneStats();
         if (line == "quit") {
             std::cout << "[Server] Shutdown requested\n";
+            printLaneStats();
             shuttingDown = true;
             shutdown(listenFd, SHUT_RDWR);
             close(listenFd);
 
-            for (auto& q : algoQ) q.push(Task{});       // poison pills
-            resultQ.push({-1,""});
+            // Poison pills, one per worker; costed past MICRO_BATCH_COST so no batch holds two
+            for (int l = 0; l < LANES; ++l)
+                for (int w = 0; w < LANE_WORKERS[l]; ++w) laneQ[l].push(Task{}, -1, 2 * MICRO_BATCH_COST);
+            resultQ.push(Response{}, -1, 0);
             return;
         }
     }
 }
 
 
-int main()
+int main(int argc, char* argv[])
 {
+    // -d <dir>: directory of the .graph files clients may name
+    std::string dir = GRAPH_DIR;
+    int flag;
+    while ((flag = getopt(argc, argv, "d:")) != -1) {
+        if (flag == 'd') dir = optarg;
+        else { std::cerr << "Usage: " << argv[0] << " [-d graph-directory]\n"; return 1; }
+    }
+    char resolved[PATH_MAX];
+    if (realpath(dir.c_str(), resolved)) graphDir = resolved;
+
+    // A client that vanished mid-response fails the send instead of killing the server
+    signal(SIGPIPE, SIG_IGN);
+
     // Create socket
     int srv = socket(AF_INET, SOCK_STREAM, 0);
     if (srv < 0) { perror("socket"); return 1; }
@@ -191,15 +565,17 @@ int main()
     if (listen(srv,10) < 0) { perror("listen"); return 1; }
 
     std::cout << "[Server] listening on " << PORT << '\n';
+    if (resultStore.ok())
+        std::cout << "[Server] result store " << STORE_PATH << ": " << resultStore.size() << " cached results\n";
+    if (!graphDir.empty()) std::cout << "[Server] serving .graph files from " << graphDir << '\n';
 
     // Start worker threads
     std::vector<std::thread> th;
     th.emplace_back(stdinWatcher, srv);
     th.emplace_back(responseWorker);
-    th.emplace_back(algorithmWorker,0,"mst");
-    th.emplace_back(algorithmWorker,1,"scc");
-    th.emplace_back(algorithmWorker,2,"maxflow");
-    th.emplace_back(algorithmWorker,3,"hamilton");
+    th.emplace_back([] { clientWriter.run(); });
+    for (int l = 0; l < LANES; ++l)
+        for (int w = 0; w < LANE_WORKERS[l]; ++w) th.emplace_back(algorithmWorker, Lane(l));
 
     // Accept client connections in loop
     while (!shuttingDown) {
@@ -210,6 +586,7 @@ int main()
             if (shuttingDown) break;
             perror("accept"); continue;
         }
+        fcntl(c, F_SETFL, fcntl(c, F_GETFL) | O_NONBLOCK); // writes go through the ClientWriter
         th.emplace_back(connectionHandler,c); // Start receiver thread per client
     }
 
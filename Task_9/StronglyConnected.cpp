@@ -0,0 +1,213 @@
+#include "StronglyConnected.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int DONE = -1;                 // colour of vertices already placed in an SCC
+constexpr size_t PARALLEL_FRONTIER = 4096; // BFS level size worth spreading over threads
+constexpr size_t BLOCK = 1024;           // frontier vertices per scheduling block
+
+struct Arcs {
+    const int64_t* offsets;
+    const int* targets;
+};
+
+inline int load(const int* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+inline void store(int* p, int v) { __atomic_store_n(p, v, __ATOMIC_RELAXED); }
+
+// Recolouring done by a search: a vertex coloured from[i] is claimed by
+// switching it to to[i] with one CAS, so concurrent searches never share it
+struct Recolor {
+    int from[2];
+    int to[2];
+    int k;
+
+    bool claim(int* color, int v) const {
+        for (int i = 0; i < k; ++i) {
+            int expected = from[i];
+            if (__atomic_compare_exchange_n(&color[v], &expected, to[i], false,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                return true;
+        }
+        return false;
+    }
+};
+
+// Breadth-first search from `source` (already claimed by the caller) over
+// vertices the recolouring claims. Appends every claimed vertex, source
+// first, to `seen`. Levels with a large frontier are split over threads.
+void search(Arcs g, int source, const Recolor& rc, int* color, unsigned threads,
+            std::vector<int>& seen) {
+    size_t lo = seen.size();
+    seen.push_back(source);
+    while (lo < seen.size()) {
+        const size_t hi = seen.size();
+        if (threads <= 1 || hi - lo < PARALLEL_FRONTIER) {
+            for (size_t i = lo; i < hi; ++i) {
+                const int u = seen[i];
+                for (int64_t a = g.offsets[u]; a < g.offsets[u + 1]; ++a) {
+                    int v = g.targets[a];
+                    if (rc.claim(color, v)) seen.push_back(v);
+                }
+            }
+        } else {
+            // Each thread gathers its part of the next level; merged after the join
+            std::vector<std::vector<int>> found(threads);
+            std::atomic<size_t> next{lo};
+            auto worker = [&](unsigned t) {
+                for (size_t b; (b = next.fetch_add(BLOCK)) < hi;) {
+                    for (size_t i = b, e = std::min(hi, b + BLOCK); i < e; ++i) {
+                        const int u = seen[i];
+                        for (int64_t a = g.offsets[u]; a < g.offsets[u + 1]; ++a) {
+                            int v = g.targets[a];
+                            if (rc.claim(color, v)) found[t].push_back(v);
+                        }
+                    }
+                }
+            };
+            ThreadPool::shared().run(threads, worker);
+            for (const auto& part : found) seen.insert(seen.end(), part.begin(), part.end());
+        }
+        lo = hi;
+    }
+}
+
+// Peel vertices with no live in-arcs or no live out-arcs; each is its own SCC
+void trim(int n, Arcs f, Arcs r, int* color, int* label) {
+    std::vector<int> in(n), out(n), queue;
+    for (int u = 0; u < n; ++u) {
+        in[u] = static_cast<int>(r.offsets[u + 1] - r.offsets[u]);
+        out[u] = static_cast<int>(f.offsets[u + 1] - f.offsets[u]);
+        if (in[u] == 0 || out[u] == 0) { color[u] = DONE; queue.push_back(u); }
+    }
+    for (size_t q = 0; q < queue.size(); ++q) {
+        const int v = queue[q];
+        label[v] = v;
+        for (int64_t a = f.offsets[v]; a < f.offsets[v + 1]; ++a) {
+            int w = f.targets[a];
+            if (color[w] != DONE && --in[w] == 0) { color[w] = DONE; queue.push_back(w); }
+        }
+        for (int64_t a = r.offsets[v]; a < r.offsets[v + 1]; ++a) {
+            int w = r.targets[a];
+            if (color[w] != DONE && --out[w] == 0) { color[w] = DONE; queue.push_back(w); }
+        }
+    }
+}
+
+// Vertices of one partition, all coloured `color`
+struct Task {
+    int color;
+    std::vector<int> verts;
+};
+
+struct Engine {
+    Arcs f, r;
+    int* color;
+    int* label;
+    std::atomic<int> nextColor{1};
+
+    // Label one SCC with its smallest member
+    void emit(const std::vector<int>& members) {
+        int low = *std::min_element(members.begin(), members.end());
+        for (int v : members) { label[v] = low; store(&color[v], DONE); }
+    }
+
+    // Forward-backward split of a partition around `pivot`: the pivot's SCC
+    // is labelled, the rest is returned as up to three smaller partitions
+    void split(const Task& t, int pivot, unsigned threads, std::vector<Task>& out) {
+        const int c = t.color;
+        const int cf = nextColor.fetch_add(3), cb = cf + 1, cs = cf + 2;
+
+        std::vector<int> fw, bw;
+        store(&color[pivot], cf);
+        search(f, pivot, Recolor{{c, 0}, {cf, 0}, 1}, color, threads, fw);
+        store(&color[pivot], cs);
+        search(r, pivot, Recolor{{cf, c}, {cs, cb}, 2}, color, threads, bw);
+
+        // Backward hits that were forward hits too form the SCC
+        Task fwOnly{cf, {}}, bwOnly{cb, {}}, rest{c, {}};
+        std::vector<int> scc;
+        for (int v : bw) (load(&color[v]) == cs ? scc : bwOnly.verts).push_back(v);
+        for (int v : fw) if (load(&color[v]) == cf) fwOnly.verts.push_back(v);
+        for (int v : t.verts) if (load(&color[v]) == c) rest.verts.push_back(v);
+        emit(scc);
+
+        for (Task* p : {&fwOnly, &bwOnly, &rest}) {
+            if (p->verts.size() == 1) emit(p->verts);
+            else if (!p->verts.empty()) out.push_back(std::move(*p));
+        }
+    }
+
+    // Phase 2: threads pop partitions off a shared stack until it is empty
+    // and nobody is still splitting one
+    void drain(std::vector<Task> stack, unsigned threads) {
+        std::mutex mu;
+        std::condition_variable cv;
+        int busy = 0;
+        auto worker = [&](unsigned) {
+            std::vector<Task> produced;
+            std::unique_lock<std::mutex> lk(mu);
+            for (;;) {
+                cv.wait(lk, [&] { return !stack.empty() || busy == 0; });
+                if (stack.empty()) return;
+                Task t = std::move(stack.back());
+                stack.pop_back();
+                ++busy;
+                lk.unlock();
+
+                // Pseudo-random pivot from the partition's colour
+                uint32_t x = static_cast<uint32_t>(t.color) * 2654435761u;
+                x ^= x >> 16;
+                split(t, t.verts[x % t.verts.size()], 1, produced);
+
+                lk.lock();
+                for (auto& p : produced) stack.push_back(std::move(p));
+                produced.clear();
+                --busy;
+                cv.notify_all();
+            }
+        };
+        ThreadPool::shared().run(threads, worker);
+    }
+};
+
+} // namespace
+
+int stronglyConnectedComponents(int n,
+                                const int64_t* offsets, const int* targets,
+                                const int64_t* rOffsets, const int* rTargets,
+                                int* label, unsigned threads) {
+    if (n <= 0) return 0;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<int> color(n, 0);
+    Engine e{{offsets, targets}, {rOffsets, rTargets}, color.data(), label};
+    trim(n, e.f, e.r, e.color, label);
+
+    // Phase 1: the live vertex with the most in*out arcs is likely in the giant SCC
+    Task all{0, {}};
+    int pivot = -1;
+    int64_t best = -1;
+    for (int u = 0; u < n; ++u) {
+        if (color[u] == DONE) continue;
+        all.verts.push_back(u);
+        int64_t score = (offsets[u + 1] - offsets[u]) * (rOffsets[u + 1] - rOffsets[u]);
+        if (score > best) { best = score; pivot = u; }
+    }
+    if (pivot >= 0) {
+        std::vector<Task> stack;
+        e.split(all, pivot, threads, stack);
+        all.verts = std::vector<int>();
+        e.drain(std::move(stack), threads);
+    }
+
+    int count = 0;
+    for (int u = 0; u < n; ++u) count += (label[u] == u);
+    return count;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+
+// Vertices + arcs below which the sequential Kosaraju pass is faster
+constexpr int64_t SCC_PARALLEL_MIN_WORK = 1 << 18;
+
+/**
+ * Parallel strongly connected components (forward-backward with trimming,
+ * after Hong, Rodia, Olukotun 2013).
+ *
+ *   trim:    a vertex with no in-arcs or no out-arcs from the live graph is an
+ *            SCC of its own; peeling them repeats until none is left
+ *   phase 1: from a high-degree pivot, forward and backward reachability are
+ *            run level by level with all threads. Their intersection is the
+ *            pivot's SCC (on real graphs usually the giant one)
+ *   phase 2: what is left falls into independent partitions (forward only,
+ *            backward only, neither); a pool of threads takes partitions off
+ *            a shared stack and splits each the same way with a sequential
+ *            forward-backward search from a random pivot
+ *
+ * The graph is given as forward and transposed CSR arrays. On return
+ * label[u] is the smallest vertex id in u's SCC, independent of thread
+ * timing. The return value is the number of SCCs. `threads = 0` uses
+ * hardware_concurrency().
+ */
+int stronglyConnectedComponents(int n,
+                                const int64_t* offsets, const int* targets,
+                                const int64_t* rOffsets, const int* rTargets,
+                                int* label, unsigned threads = 0);
@@ -0,0 +1,76 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <exception>
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+ThreadPool::ThreadPool(unsigned count) {
+    for (unsigned i = 0; i < count; ++i) threads.emplace_back(&ThreadPool::loop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(mu);
+        stopping = true;
+    }
+    work.notify_all();
+    for (auto& th : threads) th.join();
+}
+
+void ThreadPool::finish(Batch& b, std::exception_ptr error) {
+    std::lock_guard<std::mutex> lk(mu);
+    if (error && !b.error) b.error = error;
+    if (++b.finished == b.parts) done.notify_all();
+}
+
+void ThreadPool::loop() {
+    std::unique_lock<std::mutex> lk(mu);
+    for (;;) {
+        work.wait(lk, [&] { return stopping || !queue.empty(); });
+        if (queue.empty()) return;
+        Batch* b = queue.front();
+        unsigned part = b->next++;
+        if (b->next == b->parts) queue.pop_front();
+        lk.unlock();
+        // An exception goes back to the caller of run(), not out of the thread
+        std::exception_ptr error;
+        try { (*b->job)(part); } catch (...) { error = std::current_exception(); }
+        finish(*b, error);
+        lk.lock();
+    }
+}
+
+void ThreadPool::run(unsigned parts, const std::function<void(unsigned)>& job) {
+    if (parts == 0) return;
+    if (parts == 1 || threads.empty()) {
+        for (unsigned p = 0; p < parts; ++p) job(p);
+        return;
+    }
+
+    Batch b{&job, parts, 0, 0, nullptr};
+    {
+        std::lock_guard<std::mutex> lk(mu);
+        b.next = 1; // part 0 is the caller's
+        queue.push_back(&b);
+    }
+    work.notify_all();
+
+    // Run part 0, then help with whatever the pool has not picked up yet
+    for (unsigned part = 0;;) {
+        std::exception_ptr error;
+        try { job(part); } catch (...) { error = std::current_exception(); }
+        finish(b, error);
+        std::lock_guard<std::mutex> lk(mu);
+        if (b.next == parts) break;
+        part = b.next++;
+        if (b.next == parts) queue.erase(std::find(queue.begin(), queue.end(), &b));
+    }
+
+    std::unique_lock<std::mutex> lk(mu);
+    done.wait(lk, [&] { return b.finished == parts; });
+    lk.unlock();
+    if (b.error) std::rethrow_exception(b.error);
+}
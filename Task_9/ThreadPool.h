@@ -0,0 +1,57 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Process-wide pool of persistent threads for the parallel algorithm
+ * sections (push–relabel rounds, SCC search levels, Gomory–Hu windows,
+ * connectivity and graph building).
+ *
+ * Starting threads per round or per BFS level costs more than the short
+ * rounds themselves, and every lane worker doing so at once oversubscribed
+ * the machine. The pool is started once, with hardware_concurrency() - 1
+ * threads, and shared by all lane workers.
+ *
+ * run(parts, job) calls job(0) .. job(parts - 1) and returns when all are
+ * done. The caller takes parts itself until none are left unclaimed, so a
+ * call never waits on a pool that is busy with other requests; parts must
+ * not depend on running at the same time as each other. If parts throw,
+ * the first exception is rethrown from run() once every part has finished.
+ */
+class ThreadPool {
+public:
+    static ThreadPool& shared();
+
+    explicit ThreadPool(unsigned threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void run(unsigned parts, const std::function<void(unsigned)>& job);
+
+private:
+    // One run() call; lives on the caller's stack until all parts finished
+    struct Batch {
+        const std::function<void(unsigned)>* job;
+        unsigned parts;
+        unsigned next = 0;     // first unclaimed part
+        unsigned finished = 0;
+        std::exception_ptr error; // first exception thrown by a part
+    };
+
+    void loop();
+    void finish(Batch& b, std::exception_ptr error);
+
+    std::mutex mu;
+    std::condition_variable work;
+    std::condition_variable done;
+    std::deque<Batch*> queue; // batches with unclaimed parts
+    bool stopping = false;
+    std::vector<std::thread> threads;
+};
@@ -0,0 +1,57 @@
+#include "Workspace.h"
+#include <cstdint>
+
+constexpr size_t MIN_BLOCK = 64 * 1024;
+
+Workspace& Workspace::local() {
+    thread_local Workspace ws;
+    return ws;
+}
+
+Workspace::Scope::Scope(Workspace& w) : ws(w), block(w.current), used(w.used) {
+    ++ws.depth;
+}
+
+Workspace::Scope::~Scope() {
+    ws.current = block;
+    ws.used = used;
+    // Once everything is handed back, merge the blocks so the next run fits in one
+    if (--ws.depth == 0 && ws.blocks.size() > 1) ws.consolidate();
+}
+
+size_t Workspace::capacity() const {
+    size_t total = 0;
+    for (const auto& b : blocks) total += b.size;
+    return total;
+}
+
+void* Workspace::allocate(size_t bytes, size_t align) {
+    while (true) {
+        if (current < blocks.size()) {
+            Block& b = blocks[current];
+            // Align the address, not the offset: blocks are only new[]-aligned
+            uintptr_t base = reinterpret_cast<uintptr_t>(b.data.get());
+            size_t pos = ((base + used + align - 1) & ~uintptr_t(align - 1)) - base;
+            if (pos + bytes <= b.size) {
+                used = pos + bytes;
+                return b.data.get() + pos;
+            }
+            if (current + 1 < blocks.size()) { ++current; used = 0; continue; }
+        }
+        // Out of room: add a block at least twice the previous one
+        size_t size = blocks.empty() ? MIN_BLOCK : 2 * blocks.back().size;
+        if (size < bytes + align) size = bytes + align;
+        blocks.push_back(Block{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+        current = blocks.size() - 1;
+        used = 0;
+    }
+}
+
+// Replace all blocks by one block of the same total size
+void Workspace::consolidate() {
+    size_t total = capacity();
+    blocks.clear();
+    blocks.push_back(Block{std::unique_ptr<std::byte[]>(new std::byte[total]), total});
+    current = 0;
+    used = 0;
+}
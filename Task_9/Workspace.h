@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Reusable scratch memory for algorithm temporaries (seen flags, stacks,
+ * queues, parent arrays, ...).
+ *
+ * Buffers are bump-allocated and handed back by rewinding, never freed, so
+ * after the first few runs a worker thread stops touching the allocator.
+ * Each thread has its own workspace (Workspace::local()).
+ *
+ * Usage:
+ *   Workspace::Scope scope;               // rewinds on exit
+ *   int* parent = scope.take<int>(n);     // uninitialised
+ *   char* seen  = scope.take<char>(n, 0); // filled
+ */
+class Workspace {
+public:
+    // The calling thread's workspace
+    static Workspace& local();
+
+    // RAII mark: everything taken through the scope is released on exit
+    class Scope {
+    public:
+        explicit Scope(Workspace& w = Workspace::local());
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        template<typename T>
+        T* take(size_t n) {
+            static_assert(std::is_trivially_copyable<T>::value, "workspace holds plain data only");
+            return static_cast<T*>(ws.allocate(n * sizeof(T), alignof(T)));
+        }
+
+        // Uninitialised, aligned to `align` bytes (a power of two, e.g. 64 for SIMD rows)
+        template<typename T>
+        T* takeAligned(size_t n, size_t align) {
+            static_assert(std::is_trivially_copyable<T>::value, "workspace holds plain data only");
+            return static_cast<T*>(ws.allocate(n * sizeof(T), align < alignof(T) ? alignof(T) : align));
+        }
+
+        template<typename T>
+        T* take(size_t n, const T& value) {
+            T* p = take<T>(n);
+            for (size_t i = 0; i < n; ++i) p[i] = value;
+            return p;
+        }
+
+    private:
+        Workspace& ws;
+        size_t block;
+        size_t used;
+    };
+
+    // Bytes currently reserved across all blocks
+    size_t capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Block> blocks;
+    size_t current = 0; // block being bumped
+    size_t used = 0;    // bytes used in the current block
+    int depth = 0;      // open scopes
+
+    void* allocate(size_t bytes, size_t align);
+    void consolidate();
+};